@@ -0,0 +1,564 @@
+// Suite de benchmarks du core C++ (façon Criterion): échauffement, calibrage du nombre
+// d'itérations par échantillon, puis N échantillons -> moyenne, médiane, p99, min, écart-type
+// par opération. Résultats lisibles sur stdout et en JSON (--json) pour suivre les régressions
+// d'une version à l'autre (--baseline: comparaison des médianes, code de sortie 2 au-delà du seuil).
+//
+// Build:   POLYMARKET_CORE_BENCH=1 cargo build --release   (binaire: $OUT_DIR/bench_core, voir build.rs)
+//          ou g++ -std=c++17 -O3 -I"$PWD/src" bench/bench_core.cpp -o bench_core -lcurl -lsqlite3 -pthread
+// Usage:   ./bench_core [--json out.json] [--baseline ref.json] [--threshold 0.10]
+//                       [--filter roi/] [--quick] [pages/*.html]
+// Sans page capturée, une page HTML synthétique de 1 Mo sert au scan de mots-clés.
+//
+// Logs désactivés à la compilation: on mesure le calcul, pas le remplissage du ring de logs.
+#ifndef PM_LOG_LEVEL
+#define PM_LOG_LEVEL PM_LOG_LEVEL_OFF
+#endif
+// Inclus via -I src: le profil PGO d'entraînement porte les mêmes chemins source que la bibliothèque
+#include "polymarket_core.cpp"
+#include <functional>
+
+// Empêche le compilateur d'éliminer un résultat inutilisé
+template <typename T>
+static inline void keep(const T& value) {
+    asm volatile("" : : "r"(&value) : "memory");
+}
+
+struct BenchOptions {
+    string json_path;
+    string baseline_path;
+    string filter;
+    double threshold = 0.10;
+    int samples = 30;
+    double sample_ms = 5.0;
+    double warmup_ms = 100.0;
+    vector<string> pages;
+};
+
+struct BenchResult {
+    string name;
+    int samples = 0;
+    uint64_t iterations = 0;   // opérations par échantillon
+    double mean_ns = 0, median_ns = 0, p99_ns = 0, min_ns = 0, stddev_ns = 0;
+    double bytes_per_op = 0;   // > 0: débit rapporté en Mo/s
+};
+
+static BenchResult summarize(const string& name, vector<double> per_op, uint64_t iterations, double bytes_per_op) {
+    BenchResult r;
+    r.name = name;
+    r.samples = (int)per_op.size();
+    r.iterations = iterations;
+    r.bytes_per_op = bytes_per_op;
+    sort(per_op.begin(), per_op.end());
+    double sum = 0;
+    for (double v : per_op) sum += v;
+    r.mean_ns = sum / per_op.size();
+    r.median_ns = per_op[per_op.size() / 2];
+    r.p99_ns = per_op[min(per_op.size() - 1, (size_t)ceil(0.99 * per_op.size()) - 1)];
+    r.min_ns = per_op.front();
+    double var = 0;
+    for (double v : per_op) var += (v - r.mean_ns) * (v - r.mean_ns);
+    r.stddev_ns = per_op.size() > 1 ? sqrt(var / (per_op.size() - 1)) : 0.0;
+    return r;
+}
+
+class BenchRunner {
+private:
+    const BenchOptions& options;
+    vector<BenchResult> results;
+
+    static double elapsed_ns(chrono::steady_clock::time_point start) {
+        return (double)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now() - start).count();
+    }
+
+    void report(const BenchResult& r) {
+        cout << left << setw(52) << r.name << right << fixed << setprecision(1)
+             << setw(12) << r.median_ns << setw(12) << r.p99_ns << setw(10) << setprecision(1)
+             << (r.median_ns > 0 ? r.stddev_ns / r.median_ns * 100.0 : 0.0) << "%";
+        if (r.bytes_per_op > 0) cout << setw(10) << setprecision(0) << r.bytes_per_op * 1000.0 / r.median_ns << " Mo/s";
+        cout << endl;
+        results.push_back(r);
+    }
+
+public:
+    explicit BenchRunner(const BenchOptions& opts) : options(opts) {}
+
+    bool enabled(const string& name) const {
+        return options.filter.empty() || name.find(options.filter) != string::npos;
+    }
+
+    // body(iterations) exécute iterations opérations
+    template <typename F>
+    void run(const string& name, F&& body, double bytes_per_op = 0) {
+        if (!enabled(name)) return;
+
+        // Échauffement et calibrage: on double jusqu'à un échantillon de sample_ms
+        uint64_t iterations = 1;
+        auto warmup_start = chrono::steady_clock::now();
+        while (true) {
+            auto start = chrono::steady_clock::now();
+            body(iterations);
+            double ns = elapsed_ns(start);
+            if (ns >= options.sample_ms * 1e6) {
+                if (elapsed_ns(warmup_start) >= options.warmup_ms * 1e6) break;
+            } else {
+                iterations *= 2;
+            }
+            if (iterations >= (1ull << 40)) break;
+        }
+
+        vector<double> per_op;
+        per_op.reserve(options.samples);
+        for (int s = 0; s < options.samples; s++) {
+            auto start = chrono::steady_clock::now();
+            body(iterations);
+            per_op.push_back(elapsed_ns(start) / iterations);
+        }
+        report(summarize(name, move(per_op), iterations, bytes_per_op));
+    }
+
+    // body(thread, iterations) sur threads threads démarrés ensemble; temps par opération
+    // du thread le plus lent (part de débit de chacun sous contention)
+    template <typename F>
+    void run_threads(const string& name, int threads, F&& body, function<void()> background = nullptr) {
+        if (!enabled(name)) return;
+
+        auto sample = [&](uint64_t iterations) {
+            atomic<int> ready{0};
+            atomic<bool> go{false};
+            atomic<bool> done{false};
+            vector<double> thread_ns(threads);
+            vector<thread> pool;
+            for (int t = 0; t < threads; t++) {
+                pool.emplace_back([&, t]() {
+                    ready.fetch_add(1);
+                    while (!go.load(memory_order_acquire)) {}
+                    auto start = chrono::steady_clock::now();
+                    body(t, iterations);
+                    thread_ns[t] = elapsed_ns(start);
+                });
+            }
+            thread writer;
+            if (background) {
+                writer = thread([&]() {
+                    while (!done.load(memory_order_acquire)) background();
+                });
+            }
+            while (ready.load() < threads) {}
+            go.store(true, memory_order_release);
+            for (auto& th : pool) th.join();
+            done.store(true, memory_order_release);
+            if (writer.joinable()) writer.join();
+            return *max_element(thread_ns.begin(), thread_ns.end());
+        };
+
+        uint64_t iterations = 1024;
+        while (sample(iterations) < options.sample_ms * 1e6 && iterations < (1ull << 36)) iterations *= 2;
+
+        vector<double> per_op;
+        int samples = max(5, options.samples / 3);
+        for (int s = 0; s < samples; s++) per_op.push_back(sample(iterations) / iterations);
+        report(summarize(name, move(per_op), iterations, 0));
+    }
+
+    const vector<BenchResult>& all() const { return results; }
+};
+
+// ===== DONNÉES SYNTHÉTIQUES =====
+// Univers de marchés classés par la taxonomie intégrée et sources aux mots-clés du cycle réel
+
+static vector<Market> synthetic_markets(size_t n, uint32_t seed) {
+    static const vector<string> subjects = {
+        "the Fed cut the interest rate", "Bitcoin hit $150k", "Ethereum flip Bitcoin", "the US enter a recession",
+        "Q3 GDP growth exceed 2%", "Trump win the election", "the Lakers win the game", "the SEC approve a crypto ETF",
+        "CPI inflation exceed 3%", "the senate pass the bill"};
+    mt19937 rng(seed);
+    auto taxonomy = current_taxonomy();
+    vector<Market> markets(n);
+    for (size_t i = 0; i < n; i++) {
+        Market& m = markets[i];
+        m.id = "0xbench" + to_string(seed) + "_" + to_string(i);
+        m.question = "Will " + subjects[rng() % subjects.size()] + " by " + to_string(2025 + rng() % 3) + "?";
+        m.description = "This market resolves to Yes according to the official resolution source.";
+        m.probability = 0.02 + (rng() % 960) / 1000.0;
+        classify_market(m, *taxonomy);
+    }
+    return markets;
+}
+
+static map<string, SourceData> synthetic_sources(size_t n, uint32_t seed) {
+    static const vector<string> keywords = {"federal", "reserve", "rate", "gdp", "recession", "crypto", "bitcoin", "ethereum"};
+    mt19937 rng(seed);
+    map<string, SourceData> sources;
+    for (size_t i = 0; i < n; i++) {
+        SourceData data;
+        data.url = "https://source" + to_string(i) + ".example.com/feed";
+        data.accessible = true;
+        data.content_length = 50000;
+        for (const auto& keyword : keywords) {
+            if (rng() % 3 == 0) data.found_keywords.push_back(keyword);
+        }
+        sources[data.url] = data;
+    }
+    return sources;
+}
+
+static vector<pair<string, string>> load_pages(const vector<string>& paths) {
+    vector<pair<string, string>> pages;
+    for (const auto& path : paths) {
+        ifstream in(path, ios::binary);
+        if (!in) {
+            cerr << "[WARNING] Impossible de lire " << path << endl;
+            continue;
+        }
+        stringstream ss;
+        ss << in.rdbuf();
+        size_t slash = path.find_last_of('/');
+        pages.push_back({slash == string::npos ? path : path.substr(slash + 1), ss.str()});
+    }
+    if (pages.empty()) {
+        string body;
+        const char* chunk = "<div class=\"Story\"><a href=\"/news/markets\">Markets Update</a><p>Stocks and Bonds "
+                            "moved after the Treasury auction; analysts expect Volatility.</p></div>\n";
+        while (body.size() < (1 << 20)) body += chunk;
+        body += "<p>The Federal Reserve held the rate steady.</p>";
+        pages.push_back({"synthetic-1MB", body});
+    }
+    return pages;
+}
+
+// ===== SORTIE JSON ET COMPARAISON =====
+
+static string json_escape(const string& s) {
+    string out;
+    for (char c : s) {
+        if (c == '"' || c == '\\') out += '\\';
+        out += c;
+    }
+    return out;
+}
+
+static void write_json(const string& path, const vector<BenchResult>& results) {
+    ofstream out(path);
+    if (!out) {
+        cerr << "[ERROR] Impossible d'écrire " << path << endl;
+        return;
+    }
+    out << "{\n  \"suite\": \"bench_core\",\n";
+    out << "  \"timestamp\": \"" << get_current_timestamp() << "\",\n";
+    out << "  \"compiler\": \"" << json_escape(__VERSION__) << "\",\n";
+    out << "  \"scan_kernel\": \"" << active_scan_kernel().name << "\",\n";
+    out << "  \"hardware_threads\": " << thread::hardware_concurrency() << ",\n";
+    out << "  \"results\": [\n";
+    out << setprecision(6);
+    for (size_t i = 0; i < results.size(); i++) {
+        const BenchResult& r = results[i];
+        out << "    {\"name\": \"" << json_escape(r.name) << "\", \"samples\": " << r.samples
+            << ", \"iterations\": " << r.iterations << ", \"mean_ns\": " << r.mean_ns
+            << ", \"median_ns\": " << r.median_ns << ", \"p99_ns\": " << r.p99_ns
+            << ", \"min_ns\": " << r.min_ns << ", \"stddev_ns\": " << r.stddev_ns;
+        if (r.bytes_per_op > 0) out << ", \"bytes_per_op\": " << r.bytes_per_op;
+        out << "}" << (i + 1 < results.size() ? "," : "") << "\n";
+    }
+    out << "  ]\n}\n";
+}
+
+// Médianes d'un fichier produit par write_json
+static map<string, double> read_baseline(const string& path) {
+    map<string, double> medians;
+    ifstream in(path, ios::binary);
+    if (!in) return medians;
+    stringstream ss;
+    ss << in.rdbuf();
+    string text = ss.str();
+
+    JsonCursor json(text);
+    string_view key;
+    if (!json.begin_object()) return medians;
+    while (json.next_field(key)) {
+        if (key != "results") {
+            json.skip_value();
+            continue;
+        }
+        if (!json.begin_array()) break;
+        while (json.next_element()) {
+            string name;
+            double median = NAN;
+            if (!json.begin_object()) break;
+            string_view field;
+            while (json.next_field(field)) {
+                if (field == "name") json.read_string(name);
+                else if (field == "median_ns") json.read_number(median);
+                else json.skip_value();
+            }
+            if (!name.empty() && !std::isnan(median)) medians[name] = median;
+        }
+    }
+    return medians;
+}
+
+// Nombre de régressions au-delà du seuil (médiane relative)
+static int compare_baseline(const vector<BenchResult>& results, const map<string, double>& baseline, double threshold) {
+    int regressions = 0;
+    cout << "\nComparaison avec la référence (seuil " << setprecision(0) << threshold * 100 << "%)" << endl;
+    for (const auto& r : results) {
+        auto it = baseline.find(r.name);
+        if (it == baseline.end() || it->second <= 0) continue;
+        double change = r.median_ns / it->second - 1.0;
+        bool regressed = change > threshold;
+        if (regressed) regressions++;
+        cout << left << setw(52) << r.name << right << setw(9) << showpos << setprecision(1) << change * 100.0
+             << noshowpos << "%" << (regressed ? "  [REGRESSION]" : "") << endl;
+    }
+    return regressions;
+}
+
+// ===== BENCHMARKS =====
+
+static void bench_roi(BenchRunner& bench) {
+    vector<double> prices(1024);
+    mt19937 rng(7);
+    for (auto& p : prices) p = (rng() % 10000) / 10000.0;
+    const RoiContext live = live_roi.load();
+
+    bench.run("roi/calculate_real_roi", [&](uint64_t n) {
+        double acc = 0;
+        for (uint64_t i = 0; i < n; i++) acc += calculate_real_roi(live_roi.load(), prices[i & 1023]);
+        keep(acc);
+    });
+
+    bench.run("roi/calculate_roi_hft_cached", [&](uint64_t n) {
+        double acc = 0;
+        for (uint64_t i = 0; i < n; i++) acc += calculate_roi_hft_cached(prices[i & 1023], live.fee, live.catchup_speed, live.action_time);
+        keep(acc);
+    });
+
+    vector<double> out(prices.size());
+    bench.run("roi/calculate_real_roi_batch/1024", [&](uint64_t n) {
+        for (uint64_t i = 0; i < n; i++) calculate_real_roi_batch(prices.data(), prices.size(), nullptr, nullptr, out.data(), nullptr);
+        keep(out[0]);
+    });
+
+    // Contention: lecteurs concurrents sur le cache, avec et sans invalidations en continu
+    int max_threads = (int)max(2u, thread::hardware_concurrency());
+    for (int threads = 1; threads <= min(8, max_threads); threads *= 2) {
+        auto body = [&](int t, uint64_t n) {
+            double acc = 0;
+            uint32_t x = 2654435761u * (t + 1);
+            for (uint64_t i = 0; i < n; i++) {
+                x = x * 1664525u + 1013904223u;
+                acc += calculate_roi_hft_cached(prices[x >> 22], live.fee, live.catchup_speed, live.action_time);
+            }
+            keep(acc);
+        };
+        bench.run_threads("roi/calculate_roi_hft_cached/threads:" + to_string(threads), threads, body);
+        bench.run_threads("roi/calculate_roi_hft_cached/invalidating/threads:" + to_string(threads), threads, body, []() {
+            roi_params_version.fetch_add(1, memory_order_release);
+            this_thread::sleep_for(chrono::microseconds(100));
+        });
+    }
+
+    // Calibrage: 64 contextes x 10k marchés résolus, répartis par vol de travail
+    vector<double> sweep_prices(10000);
+    vector<uint8_t> outcomes(sweep_prices.size());
+    for (size_t i = 0; i < sweep_prices.size(); i++) {
+        sweep_prices[i] = (rng() % 10000) / 10000.0;
+        outcomes[i] = rng() % 2;
+    }
+    vector<RoiContext> grid;
+    for (double fee : {0.01, 0.02, 0.03, 0.05})
+        for (double speed : {0.2, 0.4, 0.8, 1.6})
+            for (double pi : {0.45, 0.5, 0.55, 0.6}) grid.push_back({fee, speed, live.action_time, live.fixed_cost, pi});
+    for (size_t threads = 1; threads <= (size_t)min(8, max_threads); threads *= 2) {
+        bench.run("roi/sweep_roi_contexts/64x10000/threads:" + to_string(threads), [&](uint64_t n) {
+            for (uint64_t i = 0; i < n; i++) keep(sweep_roi_contexts(grid, sweep_prices.data(), outcomes.data(), sweep_prices.size(), threads));
+        });
+    }
+}
+
+static void bench_detection(BenchRunner& bench) {
+    auto sources = synthetic_sources(32, 3);
+    for (size_t n : {10, 1000, 10000}) {
+        auto markets = synthetic_markets(n, (uint32_t)n);
+        string suffix = "/markets:" + to_string(n);
+
+        bench.run("detect/index_build" + suffix, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                MarketKeywordIndex index(markets);
+                keep(index);
+            }
+        });
+
+        MarketKeywordIndex index(markets);
+        bench.run("detect/detect_arbitrage_opportunities" + suffix, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto opportunities = detect_arbitrage_opportunities(markets, sources, index);
+                keep(opportunities);
+            }
+        });
+
+        vector<TradingSignal> signals;
+        for (const auto& opp : detect_arbitrage_opportunities(markets, sources, index)) signals.push_back(make_trading_signal(opp));
+        bench.run("detect/prioritize_trades_by_roi/signals:" + to_string(signals.size()), [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto ranked = prioritize_trades_by_roi(signals);
+                keep(ranked);
+            }
+        });
+
+        // Cycle incrémental complet (univers inchangé, une source modifiée) et tick temps réel
+        IncrementalSignalPipeline pipeline;
+        auto shared_index = make_shared<const MarketKeywordIndex>(markets);
+        auto cycle_sources = sources;
+        pipeline.apply(markets, shared_index, cycle_sources);
+        uint64_t flip = 0;
+        bench.run("pipeline/apply_one_source_changed" + suffix, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                auto& data = cycle_sources.begin()->second;
+                data.accessible = (++flip & 1) != 0;
+                keep(pipeline.apply(markets, shared_index, cycle_sources));
+                pipeline.take_cycle_deltas();
+            }
+        });
+
+        uint32_t symbol = market_symbols.intern(markets[0].id);
+        bench.run("pipeline/reprice_one_market" + suffix, [&](uint64_t iters) {
+            unordered_map<uint32_t, double> tick;
+            for (uint64_t i = 0; i < iters; i++) {
+                tick[symbol] = 0.1 + (i % 800) / 1000.0;
+                keep(pipeline.reprice(tick));
+            }
+            pipeline.take_cycle_deltas();
+        });
+    }
+}
+
+static void bench_keyword_scan(BenchRunner& bench, const vector<string>& paths) {
+    const vector<string> keywords = {"federal", "reserve", "rate", "gdp", "recession", "crypto", "bitcoin", "ethereum"};
+    auto automaton = keyword_automaton_for(keywords);
+    auto scanner = ci_scanner_for(keywords);
+
+    for (const auto& page : load_pages(paths)) {
+        double bytes = (double)page.second.size();
+        bench.run("scan/aho_corasick/" + page.first, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                KeywordStream stream(automaton, StreamAbortMode::NONE);
+                stream.feed(page.second.data(), page.second.size());
+                keep(stream);
+            }
+        }, bytes);
+        bench.run(string("scan/simd_") + active_scan_kernel().name + "/" + page.first, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                vector<uint8_t> found = scanner->scan(page.second.data(), page.second.size());
+                keep(found);
+            }
+        }, bytes);
+        bench.run("scan/extract_urls/" + page.first, [&](uint64_t iters) {
+            for (uint64_t i = 0; i < iters; i++) {
+                size_t count = 0;
+                scan_urls(page.second, [&](string_view) { count++; });
+                keep(count);
+            }
+        }, bytes);
+    }
+}
+
+// Aller-retour FFI: appels par pointeurs de fonction (pas d'inlining), comme depuis Rust
+static void bench_ffi(BenchRunner& bench) {
+    // Un cycle publié pour que les instantanés et deltas existent
+    auto markets = synthetic_markets(1000, 11);
+    auto sources = synthetic_sources(32, 5);
+    {
+        lock_guard<mutex> writer(update_mutex);
+        auto next = make_shared<CoreState>(*std::atomic_load(&core_state));
+        next->version++;
+        next->markets = make_shared<const vector<Market>>(markets);
+        next->source_data = make_shared<const map<string, SourceData>>(sources);
+        market_index = make_shared<const MarketKeywordIndex>(markets);
+        size_t changed = signal_pipeline.apply(markets, market_index, sources);
+        publish_pipeline_state(move(next), changed > 0);
+    }
+
+    double (*volatile roi_fn)(double, double, double, double) = calculate_real_roi_cpp;
+    double (*volatile cached_fn)(double, double, double, double) = calculate_roi_hft_cached;
+    const char* (*volatile decision_fn)(double, double) = make_trading_decision_hft;
+    bool (*volatile acquire_fn)(CoreSnapshot_C*) = acquire_core_snapshot;
+    void (*volatile release_fn)(uint64_t) = release_core_snapshot;
+    size_t (*volatile deltas_fn)(TradingSignal_C*, size_t) = fetch_signal_deltas;
+    void (*volatile stats_fn)(PipelineStats_C*) = get_pipeline_stats;
+
+    bench.run("ffi/calculate_real_roi_cpp", [&](uint64_t n) {
+        double acc = 0;
+        for (uint64_t i = 0; i < n; i++) acc += roi_fn(0.3 + (i & 255) / 1000.0, 0.03, 0.8, 0.025);
+        keep(acc);
+    });
+    bench.run("ffi/calculate_roi_hft_cached", [&](uint64_t n) {
+        double acc = 0;
+        for (uint64_t i = 0; i < n; i++) acc += cached_fn(0.3 + (i & 255) / 1000.0, 0.03, 0.8, 0.025);
+        keep(acc);
+    });
+    bench.run("ffi/make_trading_decision_hft", [&](uint64_t n) {
+        uintptr_t acc = 0;
+        for (uint64_t i = 0; i < n; i++) acc += (uintptr_t)decision_fn((i & 63) / 1000.0, 0.5);
+        keep(acc);
+    });
+    bench.run("ffi/acquire_release_core_snapshot", [&](uint64_t n) {
+        CoreSnapshot_C snapshot{};
+        for (uint64_t i = 0; i < n; i++) {
+            if (acquire_fn(&snapshot)) release_fn(snapshot.generation);
+        }
+        keep(snapshot);
+    });
+
+    vector<TradingSignal_C> out(256);
+    deltas_fn(out.data(), out.size());
+    bench.run("ffi/fetch_signal_deltas/empty", [&](uint64_t n) {
+        size_t acc = 0;
+        for (uint64_t i = 0; i < n; i++) acc += deltas_fn(out.data(), out.size());
+        keep(acc);
+    });
+    bench.run("ffi/get_pipeline_stats", [&](uint64_t n) {
+        PipelineStats_C stats{};
+        for (uint64_t i = 0; i < n; i++) stats_fn(&stats);
+        keep(stats);
+    });
+}
+
+int main(int argc, char** argv) {
+    BenchOptions options;
+    for (int i = 1; i < argc; i++) {
+        string arg = argv[i];
+        auto value = [&]() -> string { return i + 1 < argc ? argv[++i] : ""; };
+        if (arg == "--json") options.json_path = value();
+        else if (arg == "--baseline") options.baseline_path = value();
+        else if (arg == "--threshold") options.threshold = atof(value().c_str());
+        else if (arg == "--filter") options.filter = value();
+        else if (arg == "--quick") {
+            options.samples = 10;
+            options.sample_ms = 1.0;
+            options.warmup_ms = 20.0;
+        } else options.pages.push_back(arg);
+    }
+
+    cout << "bench_core | noyau de scan: " << active_scan_kernel().name
+         << " | threads matériels: " << thread::hardware_concurrency() << endl;
+    cout << left << setw(52) << "benchmark" << right << setw(12) << "median ns" << setw(12) << "p99 ns"
+         << setw(11) << "dispersion" << endl;
+
+    BenchRunner bench(options);
+    bench_roi(bench);
+    bench_detection(bench);
+    bench_keyword_scan(bench, options.pages);
+    bench_ffi(bench);
+
+    if (!options.json_path.empty()) write_json(options.json_path, bench.all());
+
+    if (!options.baseline_path.empty()) {
+        auto baseline = read_baseline(options.baseline_path);
+        if (baseline.empty()) {
+            cerr << "[ERROR] Référence illisible: " << options.baseline_path << endl;
+            return 1;
+        }
+        if (compare_baseline(bench.all(), baseline, options.threshold) > 0) return 2;
+    }
+    return 0;
+}
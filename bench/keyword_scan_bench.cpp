@@ -0,0 +1,114 @@
+// Micro-benchmark: recherche de mots-clés dans les pages sources
+// Compare le chemin historique (copie en minuscules + un find par mot-clé), l'automate
+// Aho-Corasick en streaming et les noyaux SIMD, sur des pages capturées.
+//
+// Build:   g++ -std=c++17 -O3 bench/keyword_scan_bench.cpp -o keyword_scan_bench -lcurl -lsqlite3 -pthread
+// Usage:   ./keyword_scan_bench pages/*.html
+//          (capture: curl -s https://www.cnn.com/ -o pages/cnn.html)
+// Sans argument, une page HTML synthétique de 1 Mo est utilisée.
+#include "../src/polymarket_core.cpp"
+
+struct Page {
+    string name;
+    string body;
+};
+
+static vector<Page> load_pages(int argc, char** argv) {
+    vector<Page> pages;
+    for (int i = 1; i < argc; i++) {
+        ifstream in(argv[i], ios::binary);
+        if (!in) {
+            cerr << "[WARNING] Impossible de lire " << argv[i] << endl;
+            continue;
+        }
+        stringstream ss;
+        ss << in.rdbuf();
+        pages.push_back({argv[i], ss.str()});
+    }
+    if (pages.empty()) {
+        string body;
+        const char* chunk = "<div class=\"Story\"><a href=\"/news/markets\">Markets Update</a><p>Stocks and Bonds "
+                            "moved after the Treasury auction; analysts expect Volatility.</p></div>\n";
+        while (body.size() < (1 << 20)) body += chunk;
+        body += "<p>The Federal Reserve held the rate steady.</p>";
+        pages.push_back({"synthetic-1MB", body});
+    }
+    return pages;
+}
+
+// Chemin historique de monitor_resolution_source()
+static vector<string> baseline_scan(const string& body, const vector<string>& keywords) {
+    vector<string> found;
+    string lower = body;
+    transform(lower.begin(), lower.end(), lower.begin(), ::tolower);
+    for (const auto& keyword : keywords) {
+        if (lower.find(keyword) != string::npos) found.push_back(keyword);
+    }
+    return found;
+}
+
+template <typename F>
+static double best_ns(F&& fn, int iterations) {
+    double best = 1e300;
+    for (int i = 0; i < iterations; i++) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        auto end = chrono::steady_clock::now();
+        best = min(best, (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const vector<string> keywords = {"federal", "reserve", "rate", "gdp", "recession", "crypto", "bitcoin", "ethereum"};
+    const int iterations = 50;
+    
+    vector<Page> pages = load_pages(argc, argv);
+    auto automaton = keyword_automaton_for(keywords);
+    auto scanner = ci_scanner_for(keywords);
+    
+    vector<pair<string, ScanKernel>> kernels = {{"simd-scalar", scan_kernel_scalar}};
+#if defined(__x86_64__)
+    kernels.push_back({"simd-sse2", scan_kernel_sse2});
+    __builtin_cpu_init();
+    if (__builtin_cpu_supports("avx2")) kernels.push_back({"simd-avx2", scan_kernel_avx2});
+#elif defined(__aarch64__)
+    kernels.push_back({"simd-neon", scan_kernel_neon});
+#endif
+    
+    cout << "Noyau actif: " << active_scan_kernel().name << endl;
+    cout << left << setw(28) << "page" << setw(14) << "variant" << right << setw(12) << "us" << setw(10) << "GB/s" << endl;
+    
+    for (const auto& page : pages) {
+        vector<string> expected = baseline_scan(page.body, keywords);
+        double bytes = (double)page.body.size();
+        
+        auto report = [&](const string& variant, double ns, const vector<string>& got) {
+            cout << left << setw(28) << page.name.substr(0, 27) << setw(14) << variant << right
+                 << setw(12) << fixed << setprecision(1) << ns / 1000.0
+                 << setw(10) << setprecision(2) << bytes / ns
+                 << (got == expected ? "" : "  [MISMATCH]") << endl;
+        };
+        
+        vector<string> got;
+        report("baseline", best_ns([&]() { got = baseline_scan(page.body, keywords); }, iterations), got);
+        
+        report("aho-corasick", best_ns([&]() {
+            KeywordStream stream(automaton, StreamAbortMode::NONE);
+            stream.feed(page.body.data(), page.body.size());
+            got = stream.found_keywords();
+        }, iterations), got);
+        
+        for (const auto& [name, kernel] : kernels) {
+            report(name, best_ns([&]() {
+                vector<uint8_t> found = scanner->scan(page.body.data(), page.body.size(), kernel);
+                got.clear();
+                for (size_t k = 0; k < found.size(); k++) {
+                    if (found[k]) got.push_back(scanner->keyword(k));
+                }
+            }, iterations), got);
+        }
+    }
+    
+    return 0;
+}
@@ -0,0 +1,108 @@
+// Micro-benchmark: extraction d'URL dans les descriptions de marchés
+// Compare l'ancien chemin std::regex (https?://[^\s]+ recompilé à chaque appel, sregex_iterator)
+// au scanner manuel scan_urls(), en copies (extract_urls) et en vues (extract_url_views).
+//
+// Build:   g++ -std=c++17 -O3 bench/url_scan_bench.cpp -o url_scan_bench -lcurl -lsqlite3 -pthread
+// Usage:   ./url_scan_bench descriptions.txt
+//          (une description par ligne, ex. extraite de /markets: jq -r '.data[].description')
+// Sans argument, 5000 descriptions synthétiques sont générées.
+#include "../src/polymarket_core.cpp"
+#include <regex>
+
+static vector<string> load_descriptions(int argc, char** argv) {
+    vector<string> descriptions;
+    for (int i = 1; i < argc; i++) {
+        ifstream in(argv[i]);
+        if (!in) {
+            cerr << "[WARNING] Impossible de lire " << argv[i] << endl;
+            continue;
+        }
+        string line;
+        while (getline(in, line)) {
+            if (!line.empty()) descriptions.push_back(line);
+        }
+    }
+    if (descriptions.empty()) {
+        mt19937 rng(42);
+        const vector<string> words = {"This", "market", "will", "resolve", "to", "\"Yes\"", "if", "the",
+                                      "official", "announcement", "is", "made", "before", "December", "31,"};
+        const vector<string> urls = {"https://www.federalreserve.gov/newsevents/pressreleases.htm",
+                                     "https://www.bls.gov/cpi/", "http://example.com/a?b=c",
+                                     "https://polymarket.com/event/x\n", "(https://apnews.com/politics)."};
+        for (int i = 0; i < 5000; i++) {
+            string text;
+            int length = 40 + rng() % 80;
+            for (int w = 0; w < length; w++) {
+                if (rng() % 25 == 0) text += urls[rng() % urls.size()];
+                else text += words[rng() % words.size()];
+                text += (rng() % 10 == 0) ? '\t' : ' ';
+            }
+            descriptions.push_back(text);
+        }
+    }
+    return descriptions;
+}
+
+// Chemin historique de extract_urls()
+static vector<string> regex_extract(const string& text) {
+    vector<string> urls;
+    regex url_pattern(R"((https?://[^\s]+))");
+    for (sregex_iterator i(text.begin(), text.end(), url_pattern), end; i != end; ++i) {
+        urls.push_back(i->str());
+    }
+    return urls;
+}
+
+template <typename F>
+static double best_ns(F&& fn, int iterations) {
+    double best = 1e300;
+    for (int i = 0; i < iterations; i++) {
+        auto start = chrono::steady_clock::now();
+        fn();
+        auto end = chrono::steady_clock::now();
+        best = min(best, (double)chrono::duration_cast<chrono::nanoseconds>(end - start).count());
+    }
+    return best;
+}
+
+int main(int argc, char** argv) {
+    const int iterations = 10;
+    vector<string> descriptions = load_descriptions(argc, argv);
+
+    size_t bytes = 0;
+    size_t mismatches = 0;
+    size_t url_count = 0;
+    for (const auto& text : descriptions) {
+        bytes += text.size();
+        vector<string> expected = regex_extract(text);
+        url_count += expected.size();
+        if (extract_urls(text) != expected) mismatches++;
+    }
+
+    cout << descriptions.size() << " descriptions, " << bytes << " octets, " << url_count << " URLs";
+    cout << (mismatches ? "  [MISMATCH x" + to_string(mismatches) + "]" : "") << endl;
+    cout << left << setw(14) << "variant" << right << setw(12) << "us" << setw(12) << "ns/desc" << setw(10) << "MB/s" << endl;
+
+    auto report = [&](const string& variant, double ns) {
+        cout << left << setw(14) << variant << right
+             << setw(12) << fixed << setprecision(1) << ns / 1000.0
+             << setw(12) << ns / descriptions.size()
+             << setw(10) << setprecision(1) << bytes * 1000.0 / ns << endl;
+    };
+
+    size_t sink = 0;
+    report("std::regex", best_ns([&]() {
+        for (const auto& text : descriptions) sink += regex_extract(text).size();
+    }, iterations));
+    report("scan-copies", best_ns([&]() {
+        for (const auto& text : descriptions) sink += extract_urls(text).size();
+    }, iterations));
+    report("scan-views", best_ns([&]() {
+        for (const auto& text : descriptions) sink += extract_url_views(text).size();
+    }, iterations));
+    report("scan-inline", best_ns([&]() {
+        for (const auto& text : descriptions) scan_urls(text, [&](string_view url) { sink += url.size(); });
+    }, iterations));
+
+    return sink == 0 ? 1 : 0;
+}
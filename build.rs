@@ -1,48 +1,114 @@
 use std::env;
 use std::path::Path;
 
+// Options de compilation du core C++ (variables d'environnement):
+//   CXX / AR                        compilateur et archiveur (g++ / ar par défaut)
+//   POLYMARKET_CORE_NATIVE=1        -march=native (binaire non portable; sinon noyaux SIMD choisis à l'exécution)
+//   POLYMARKET_CORE_LTO=1           LTO inter-langages (clang: -flto=thin, avec
+//                                   RUSTFLAGS="-Clinker-plugin-lto -Clinker=clang -Clink-arg=-fuse-ld=lld")
+//   POLYMARKET_CORE_PGO=<dossier>   profil d'entraînement (gcc) produit par scripts/pgo_build.sh
+//   POLYMARKET_CORE_BENCH=1         construit aussi bench/bench_core.cpp
+fn env_flag(name: &str) -> bool {
+    println!("cargo:rerun-if-env-changed={}", name);
+    env::var(name).map(|v| v == "1").unwrap_or(false)
+}
+
+fn env_or(name: &str, default: &str) -> String {
+    println!("cargo:rerun-if-env-changed={}", name);
+    env::var(name).unwrap_or_else(|_| default.to_string())
+}
+
+fn run(command: &mut std::process::Command, what: &str) {
+    let status = command.status().unwrap_or_else(|_| panic!("Failed to run {}", what));
+    if !status.success() {
+        panic!("Failed to {}", what);
+    }
+}
+
 fn main() {
     println!("cargo:rerun-if-changed=src/polymarket_core.cpp");
-    
-    // Compiler le code C++
+
     let out_dir = env::var("OUT_DIR").unwrap();
-    let src_dir = "src";
-    
-    // Compiler en objet
-    let status = std::process::Command::new("g++")
-        .args(&[
-            "-std=c++17",
-            "-c",
-            "-fPIC",
-            "-o", &format!("{}/polymarket_core.o", out_dir),
-            &format!("{}/polymarket_core.cpp", src_dir)
-        ])
-        .status()
-        .expect("Failed to compile C++ object");
-    
-    if !status.success() {
-        panic!("Failed to compile C++ object");
+    let manifest_dir = env::var("CARGO_MANIFEST_DIR").unwrap();
+    let source = Path::new(&manifest_dir).join("src/polymarket_core.cpp");
+    let cxx = env_or("CXX", "g++");
+    let is_clang = cxx.contains("clang");
+    let lto = env_flag("POLYMARKET_CORE_LTO");
+    let native = env_flag("POLYMARKET_CORE_NATIVE");
+    let pgo_dir = env_or("POLYMARKET_CORE_PGO", "");
+
+    // Flags communs au core et aux benchmarks (scripts/pgo_build.sh entraîne avec les mêmes)
+    let mut flags: Vec<String> = vec!["-std=c++17".into(), "-fPIC".into()];
+    match env::var("OPT_LEVEL").unwrap_or_default().as_str() {
+        "0" => flags.push("-O0".into()),
+        "1" => flags.push("-O1".into()),
+        "s" | "z" => flags.push("-Os".into()),
+        _ => flags.push("-O3".into()),
     }
-    
-    // Créer la bibliothèque dynamique
-    let status = std::process::Command::new("g++")
-        .args(&[
-            "-shared",
-            "-o", &format!("{}/libpolymarket_core.dylib", out_dir),
-            &format!("{}/polymarket_core.o", out_dir),
-            "-lcurl",
-            "-lsqlite3"
-        ])
-        .status()
-        .expect("Failed to create dynamic library");
-    
-    if !status.success() {
-        panic!("Failed to create dynamic library");
+    if env::var("DEBUG").map(|v| v == "true").unwrap_or(false) {
+        flags.push("-g".into());
+    }
+    if native {
+        flags.push("-march=native".into());
+    }
+
+    // Compiler en objet (depuis OUT_DIR: le nom du profil PGO ne dépend que de l'objet)
+    let mut compile = std::process::Command::new(&cxx);
+    compile.current_dir(&out_dir).args(&flags);
+    if lto {
+        if is_clang {
+            compile.arg("-flto=thin");
+        } else {
+            println!("cargo:warning=POLYMARKET_CORE_LTO ignoré: le LTO avec rustc demande clang (CXX=clang++)");
+        }
     }
-    
+    if !pgo_dir.is_empty() {
+        let profile = Path::new(&pgo_dir).join("polymarket_core.gcda");
+        println!("cargo:rerun-if-changed={}", profile.display());
+        if is_clang {
+            println!("cargo:warning=POLYMARKET_CORE_PGO ignoré: profil au format gcc (.gcda)");
+        } else if profile.exists() {
+            compile.args(&[
+                format!("-fprofile-use={}", pgo_dir),
+                format!("-fprofile-prefix-path={}", out_dir),
+                "-fprofile-partial-training".to_string(),
+                "-Wno-missing-profile".to_string(),
+            ]);
+        } else {
+            println!("cargo:warning=POLYMARKET_CORE_PGO: {} introuvable, build sans profil", profile.display());
+        }
+    }
+    compile.args(&["-c", "-o", "polymarket_core.o"]).arg(&source);
+    run(&mut compile, "compile C++ object");
+
+    // Bibliothèque statique liée dans le binaire Rust (pas de chemin de chargement à l'exécution)
+    let ar = env_or("AR", if lto && is_clang { "llvm-ar" } else { "ar" });
+    let archive = Path::new(&out_dir).join("libpolymarket_core.a");
+    let _ = std::fs::remove_file(&archive);
+    run(std::process::Command::new(&ar)
+            .current_dir(&out_dir)
+            .args(&["crs", "libpolymarket_core.a", "polymarket_core.o"]),
+        "create static library");
+
     // Dire à Rust où trouver la bibliothèque
+    let cxx_runtime = if env::var("CARGO_CFG_TARGET_OS").map(|os| os == "macos").unwrap_or(false) { "c++" } else { "stdc++" };
     println!("cargo:rustc-link-search=native={}", out_dir);
-    println!("cargo:rustc-link-lib=dylib=polymarket_core");
+    println!("cargo:rustc-link-lib=static=polymarket_core");
+    println!("cargo:rustc-link-lib=dylib={}", cxx_runtime);
     println!("cargo:rustc-link-lib=dylib=curl");
     println!("cargo:rustc-link-lib=dylib=sqlite3");
+
+    // Benchmarks du core (bench/bench_core.cpp), seulement sur demande: POLYMARKET_CORE_BENCH=1
+    println!("cargo:rerun-if-changed=bench/bench_core.cpp");
+    if env_flag("POLYMARKET_CORE_BENCH") {
+        let bench_path = Path::new(&out_dir).join("bench_core");
+        run(std::process::Command::new(&cxx)
+                .args(&flags)
+                .arg(format!("-I{}", Path::new(&manifest_dir).join("src").display()))
+                .arg("-o").arg(&bench_path)
+                .arg(Path::new(&manifest_dir).join("bench/bench_core.cpp"))
+                .args(&["-lcurl", "-lsqlite3", "-pthread"]),
+            "compile C++ benchmarks");
+        println!("cargo:warning=bench_core: {}", bench_path.display());
+    }
 }
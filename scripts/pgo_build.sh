@@ -0,0 +1,49 @@
+#!/usr/bin/env bash
+# Build PGO du core C++ (gcc), en trois étapes:
+#   1. bench/bench_core.cpp instrumenté (-fprofile-generate); il inclut le core via -I src, donc
+#      les fonctions du core y portent les mêmes chemins source que dans la bibliothèque
+#   2. entraînement: la suite de benchmarks (et les pages capturées passées en argument)
+#   3. cargo build --release avec POLYMARKET_CORE_PGO pointant sur le profil
+#
+# Usage:   scripts/pgo_build.sh [pages/*.html]
+# Env:     POLYMARKET_CORE_PGO_DIR (défaut target/pgo), CXX, POLYMARKET_CORE_NATIVE=1
+#          Les flags d'optimisation doivent rester ceux du build release de build.rs.
+set -euo pipefail
+
+ROOT=$(cd "$(dirname "$0")/.." && pwd)
+PGO_DIR=${POLYMARKET_CORE_PGO_DIR:-$ROOT/target/pgo}
+WORK=$PGO_DIR/train
+CXX=${CXX:-g++}
+
+FLAGS=(-std=c++17 -fPIC -O3)
+if [ "${POLYMARKET_CORE_NATIVE:-0}" = 1 ]; then
+    FLAGS+=(-march=native)
+fi
+
+rm -rf "$PGO_DIR"
+mkdir -p "$WORK"
+
+# Pages relatives au répertoire d'appel
+PAGES=()
+for page in "$@"; do
+    PAGES+=("$(cd "$(dirname "$page")" && pwd)/$(basename "$page")")
+done
+
+echo "[PGO] Instrumentation ($CXX ${FLAGS[*]})"
+cd "$WORK"
+# Même niveau de log que la bibliothèque: le profil doit couvrir le code réellement livré
+"$CXX" "${FLAGS[@]}" -DPM_LOG_LEVEL=PM_LOG_LEVEL_INFO -I"$ROOT/src" \
+    -fprofile-generate="$PGO_DIR" -fprofile-prefix-path="$WORK" -fprofile-update=atomic \
+    -c "$ROOT/bench/bench_core.cpp" -o polymarket_core.o
+"$CXX" polymarket_core.o -o bench_core_instrumented -fprofile-generate -lcurl -lsqlite3 -pthread
+
+echo "[PGO] Entraînement"
+./bench_core_instrumented --quick ${PAGES[@]+"${PAGES[@]}"} > training.log
+if [ ! -f "$PGO_DIR/polymarket_core.gcda" ]; then
+    echo "[PGO] Aucun profil produit dans $PGO_DIR" >&2
+    exit 1
+fi
+
+echo "[PGO] Build release avec $PGO_DIR/polymarket_core.gcda"
+cd "$ROOT"
+POLYMARKET_CORE_PGO="$PGO_DIR" cargo build --release
@@ -12,21 +12,123 @@ use serde::{Deserialize, Serialize};
 use serde_json::Value;
 use std::ffi::{CStr, CString, c_char};
 
+// Latences mesurées d'un hôte par le core, en secondes (NaN sans mesure)
+#[repr(C)]
+#[derive(Default)]
+#[allow(dead_code)]
+struct HostLatencyStatsC {
+    samples: u64,
+    failures: u64,
+    dns_ewma: f64,
+    connect_ewma: f64,
+    tls_ewma: f64,
+    ttfb_ewma: f64,
+    total_ewma: f64,
+    ttfb_p50: f64,
+    ttfb_p99: f64,
+    total_p50: f64,
+    total_p99: f64,
+}
+
+// Distribution d'une étape du pipeline C++, en microsecondes (NaN sans mesure)
+#[repr(C)]
+#[derive(Default, Clone, Copy)]
+#[allow(dead_code)]
+struct StageLatencyC {
+    count: u64,
+    p50_us: f64,
+    p99_us: f64,
+    max_us: f64,
+}
+
+#[repr(C)]
+#[derive(Default)]
+#[allow(dead_code)]
+struct PipelineStatsC {
+    fetch: StageLatencyC,
+    parse: StageLatencyC,
+    match_: StageLatencyC,
+    detect: StageLatencyC,
+    price: StageLatencyC,
+    decide: StageLatencyC,
+    emit: StageLatencyC,
+    reaction: StageLatencyC,
+    end_to_end: StageLatencyC,
+}
+
+// Paramètres d'un calcul ROI C++ (RoiContext)
+#[repr(C)]
+#[derive(Default, Clone, Copy)]
+#[allow(dead_code)]
+struct RoiContextC {
+    fee: f64,
+    catchup_speed: f64,
+    action_time: f64,
+    fixed_cost: f64,
+    pi_yes: f64,
+}
+
+// Résultat d'un rejeu C++ (run_replay_sweep); pnl en € pour 1€ par trade exécuté
+#[repr(C)]
+#[derive(Default, Clone, Copy)]
+#[allow(dead_code)]
+struct ReplayResultC {
+    events: u64,
+    cycles: u64,
+    signals: u64,
+    executions: u64,
+    trades: u64,
+    wins: u64,
+    pnl: f64,
+    max_drawdown: f64,
+    signal_hash: u64,
+}
+
 // FFI declarations for C++ core
 extern "C" {
     fn init_polymarket_core() -> bool;
     fn configure_roi_params(fee: f64, catchup_speed: f64, action_time: f64);
+    fn configure_roi_context(context: *const RoiContextC);
+    fn get_roi_context(out: *mut RoiContextC);
+    fn sweep_roi_params(grid: *const RoiContextC, n_params: usize, prices: *const f64, outcomes: *const u8,
+                        n_markets: usize, threads: usize, out_expected_roi: *mut f64, out_hit_rate: *mut f64,
+                        out_realized_roi: *mut f64, out_trades: *mut u32) -> usize;
     fn update_market_data() -> bool;
+    fn start_market_feed(url: *const c_char) -> bool;
+    fn stop_market_feed();
+    fn get_market_feed_messages() -> u64;
+    fn load_order_book(market_id: *const c_char, bid_prices: *const f64, bid_sizes: *const f64, n_bids: usize,
+                       ask_prices: *const f64, ask_sizes: *const f64, n_asks: usize) -> bool;
+    fn calculate_depth_roi_cpp(market_id: *const c_char, stake: f64, bet_on_yes: bool) -> f64;
+    fn open_history_store(path: *const c_char) -> bool;
+    fn query_market_ticks(market_id: *const c_char, from_ts: f64, to_ts: f64,
+                          out_ts: *mut f64, out_price: *mut f64, cap: usize) -> usize;
     fn calculate_real_roi_cpp(current_price: f64, fee: f64, catchup_speed: f64, action_time: f64) -> f64;
+    fn export_replay_log(db_path: *const c_char, from_ts: f64, to_ts: f64, out_path: *const c_char) -> bool;
+    fn run_replay_sweep(log_path: *const c_char, from_ts: f64, to_ts: f64, fees: *const f64,
+                        catchup_speeds: *const f64, action_times: *const f64, n: usize, threads: usize,
+                        out: *mut ReplayResultC, trace_prefix: *const c_char) -> usize;
     
     // Nouvelles fonctions HFT ultra-optimisées
     fn calculate_roi_hft_cached(current_price: f64, fee: f64, catchup_speed: f64, action_time: f64) -> f64;
+    fn calculate_roi_table_cpp(price: f64) -> f64;
+    fn calculate_real_roi_batch(prices: *const f64, n: usize, catchup_speeds: *const f64,
+                                action_times: *const f64, out_roi: *mut f64, out_bet_yes: *mut u8);
+    fn set_roi_trace_sink(sink: Option<extern "C" fn(*const c_char)>, max_per_second: i32);
     fn make_trading_decision_hft(roi: f64, confidence: f64) -> *const c_char;
     fn calculate_position_size_hft(capital: f64, roi: f64, confidence: *const c_char) -> f64;
     fn validate_trade_hft(market_id: *const c_char, amount: f64, current_balance: f64) -> bool;
     fn estimate_network_latency_hft() -> f64;
     fn predict_latency_hft(endpoint: *const c_char) -> f64;
+    fn get_host_latency_quantile(host: *const c_char, q: f64) -> f64;
+    fn get_host_latency_stats(host: *const c_char, out: *mut HostLatencyStatsC) -> bool;
+    fn get_pipeline_stats(out: *mut PipelineStatsC);
+    fn register_resolution_source(url: *const c_char) -> bool;
+    fn load_market_taxonomy(path: *const c_char) -> bool;
+    fn classify_market_domain(question: *const c_char, description: *const c_char) -> *const c_char;
+    fn configure_source_budget(requests_per_second: f64);
     fn optimize_memory_hft();
+    fn flush_core_logs();
     fn cleanup_hft_cache();
 }
 
@@ -138,6 +240,7 @@ struct Bot {
     // Price history tracking for ROI calculation
     price_history: HashMap<String, Vec<(f64, f64)>>, // market_id -> [(timestamp, price)]
     market_convergence_speeds: HashMap<String, Vec<f64>>, // market_id -> [speeds]
+    market_domains: HashMap<String, String>, // market_id -> domaine, classé une fois par marché
 }
 
 impl Bot {
@@ -169,6 +272,7 @@ impl Bot {
             simulated_balance: 100.0, // Capital de départ
             price_history: HashMap::new(),
             market_convergence_speeds: HashMap::new(),
+            market_domains: HashMap::new(),
         }
     }
 
@@ -233,12 +337,20 @@ impl Bot {
                                                             false
                                                         };
                                                         
-                                                        let domain = self.extract_domain_from_question(question);
+                                                        let description = market_data.get("description").and_then(|v| v.as_str()).unwrap_or("");
+                                                        let domain = match self.market_domains.get(id) {
+                                                            Some(domain) => domain.clone(),
+                                                            None => {
+                                                                let domain = self.categorize_market_domain(question);
+                                                                self.market_domains.insert(id.to_string(), domain.clone());
+                                                                domain
+                                                            }
+                                                        };
                                                         
                                                         let market = Market {
                                                             id: id.to_string(),
                                                             question: question.to_string(),
-                                                            description: market_data.get("description").and_then(|v| v.as_str()).unwrap_or("").to_string(),
+                                                            description: description.to_string(),
                                                             domain,
                                                             probability: probability * 100.0, // Convertir en pourcentage
                                                             resolution_source: market_data.get("resolution_source").and_then(|v| v.as_str()).unwrap_or("").to_string(),
@@ -590,17 +702,19 @@ impl Bot {
         (false, "".to_string())
     }
 
-    fn categorize_market_domain(&self, question: &str, description: &str) -> String {
-        let text = format!("{} {}", question, description).to_lowercase();
-        
-        if text.contains("trump") || text.contains("election") || text.contains("president") || text.contains("biden") {
-            "politics".to_string()
-        } else if text.contains("bitcoin") || text.contains("crypto") || text.contains("etf") || text.contains("sec") {
-            "crypto".to_string()
-        } else if text.contains("fed") || text.contains("rate") || text.contains("inflation") || text.contains("economy") {
-            "economy".to_string()
-        } else {
-            "other".to_string()
+    // Taxonomie partagée avec le core C++ (config/market_taxonomy.json), appliquée à la question seule
+    // comme l'ancienne règle Rust; les domaines sans sources côté Rust (sports, health...) restent "general"
+    fn categorize_market_domain(&self, question: &str) -> String {
+        let c_question = CString::new(question).unwrap_or_default();
+        let c_description = CString::new("").unwrap();
+        let domain = unsafe {
+            CStr::from_ptr(classify_market_domain(c_question.as_ptr(), c_description.as_ptr()))
+                .to_string_lossy()
+                .into_owned()
+        };
+        match domain.as_str() {
+            "crypto" | "economy" | "politics" => domain,
+            _ => "general".to_string(),
         }
     }
 
@@ -1445,65 +1559,6 @@ impl Bot {
         }
     }
 
-    // UNIFIED ROI CALCULATION - C++ only (simplified)
-    fn calculate_potential_roi_v2(&self, _information_value: bool, polymarket_probability: f64, 
-                                 polymarket_fee: f64, _time_factor: f64, market_status: &str) -> f64 {
-        if market_status == "closed" {
-            return 0.0;
-        }
-        
-        // Use C++ HFT calculation only
-        let current_price = polymarket_probability;
-        let action_time = 0.01; // 10ms default
-        
-        unsafe {
-            calculate_roi_hft_cached(
-                current_price,
-                polymarket_fee,
-                0.025, // catchup_speed 2.5%/s
-                action_time
-            )
-        }
-    }
-
-    // UNIFIED ROI CALCULATION - C++ only
-    fn calculate_potential_roi(&self, _relevance_score: f64, information_value: bool, 
-                              polymarket_probability: f64, polymarket_fee: f64,
-                              time_factor: f64, market_status: &str, _use_v2: bool) -> HashMap<String, f64> {
-        // Use C++ HFT calculation only
-        let current_price = polymarket_probability;
-        let action_time = 0.01; // 10ms default
-        
-        let roi = unsafe {
-            calculate_roi_hft_cached(
-                current_price,
-                polymarket_fee,
-                0.025, // catchup_speed 2.5%/s
-                action_time
-            )
-        };
-        
-        let mut result = HashMap::new();
-        result.insert("roi_v2".to_string(), roi);
-        result.insert("primary_roi".to_string(), roi);
-        result
-    }
-
-    // UNIFIED ROI CALCULATION - Using C++ HFT only
-    fn calculate_new_roi(&self, current_price: f64, action_time_ms: f64, market_id: &str, 
-                        information_value: bool, fee: f64) -> (f64, f64, f64) {
-        // Use C++ HFT calculation for unified ROI
-        let action_time_seconds = action_time_ms / 1000.0;
-        
-        unsafe {
-            let roi = calculate_roi_hft_cached(current_price, fee, 0.025, action_time_seconds);
-            let catchup_speed = 0.025; // 2.5% per second (unified)
-            let spent_price = current_price + (catchup_speed * action_time_seconds);
-            
-            (roi, catchup_speed, spent_price)
-        }
-    }
-
     // Fonctions supprimées - maintenant gérées par le C++ via FFI
 
     // Mettre à jour l'historique des prix pour un marché
@@ -1517,6 +1572,24 @@ impl Bot {
         let needs_history = !self.price_history.contains_key(market_id) || 
                            self.price_history.get(market_id).unwrap().is_empty();
         
+        // Premier prix pour ce marché: historique persistant (24h) avant toute requête réseau
+        if needs_history {
+            let c_market_id = CString::new(market_id).unwrap_or_default();
+            let mut ts = vec![0.0f64; 100];
+            let mut prices = vec![0.0f64; 100];
+            let n = unsafe {
+                query_market_ticks(c_market_id.as_ptr(), current_time - 86400.0, current_time,
+                                   ts.as_mut_ptr(), prices.as_mut_ptr(), ts.len())
+            };
+            if n >= 2 {
+                let entry = self.price_history.entry(market_id.to_string()).or_insert_with(Vec::new);
+                entry.extend(ts.iter().cloned().zip(prices.iter().cloned()).take(n));
+                println!("    [HISTORIQUE] {} points repris de l'historique local pour {}", n, market_id);
+            }
+        }
+        let needs_history = !self.price_history.contains_key(market_id) || 
+                           self.price_history.get(market_id).unwrap().is_empty();
+        
         // Si c'est le premier prix pour ce marché, essayer de récupérer l'historique réel
         if needs_history {
             match self.fetch_real_price_history(market_id).await {
@@ -1784,7 +1857,17 @@ impl Bot {
         let mut price_updates = Vec::new();
         let mut convergence_updates = Vec::<(String, f64)>::new();
         
-        for opportunity in &self.opportunities {
+        // ROI de toutes les opportunités en un seul appel FFI (contexte ROI live du core)
+        let opportunity_prices: Vec<f64> = self.opportunities.iter()
+            .map(|opportunity| self.estimate_polymarket_probability(opportunity))
+            .collect();
+        let mut expected_rois = vec![0.0f64; opportunity_prices.len()];
+        unsafe {
+            calculate_real_roi_batch(opportunity_prices.as_ptr(), opportunity_prices.len(), std::ptr::null(),
+                                     std::ptr::null(), expected_rois.as_mut_ptr(), std::ptr::null_mut());
+        }
+        
+        for (opportunity_index, opportunity) in self.opportunities.iter().enumerate() {
             let signal_start_time = SystemTime::now()
                 .duration_since(UNIX_EPOCH)
                 .unwrap()
@@ -1792,18 +1875,7 @@ impl Bot {
             
             let relevance_score = opportunity.relevance_score;
             let information_value = self.estimate_information_value(opportunity);
-            let polymarket_probability = self.estimate_polymarket_probability(opportunity);
-            
-            // Calculer ROI avec les deux formules
-            let _roi_data = self.calculate_potential_roi(
-                relevance_score,
-                information_value,
-                polymarket_probability,
-                0.02, // fee 2%
-                1.1,  // time_factor
-                "open",
-                true  // use_v2
-            );
+            let polymarket_probability = opportunity_prices[opportunity_index];
             
             // Utiliser le ROI HFT basé sur l'historique des prix
             let current_price = polymarket_probability; // Prix actuel du marché
@@ -1855,15 +1927,8 @@ impl Bot {
     let estimated_execution_ms = self.estimate_trade_execution_time("MONITOR", polymarket_probability, relevance_score);
     let total_latency_ms = reaction_time_ms + estimated_execution_ms;
     
-        // Calculer le ROI avec cache C++
-    let expected_roi = unsafe {
-        calculate_roi_hft_cached(
-            current_price,
-            0.02, // fee 2%
-            0.025, // catchup_speed 2.5%/s
-            total_latency_ms / 1000.0 // action_time en secondes
-        )
-    };
+        // ROI calculé en lot avant la boucle (current_price == polymarket_probability)
+    let expected_roi = expected_rois[opportunity_index];
     
     // Décision ultra-rapide avec C++ (latence < 100ns)
     let action = unsafe {
@@ -1972,26 +2037,6 @@ impl Bot {
     }
 
     // Extraire le domaine d'une question
-    fn extract_domain_from_question(&self, question: &str) -> String {
-        let question_lower = question.to_lowercase();
-        
-        if question_lower.contains("bitcoin") || question_lower.contains("ethereum") || 
-           question_lower.contains("crypto") || question_lower.contains("blockchain") ||
-           question_lower.contains("defi") || question_lower.contains("nft") {
-            "crypto".to_string()
-        } else if question_lower.contains("fed") || question_lower.contains("federal") ||
-                  question_lower.contains("rate") || question_lower.contains("economy") ||
-                  question_lower.contains("inflation") || question_lower.contains("gdp") {
-            "economy".to_string()
-        } else if question_lower.contains("election") || question_lower.contains("president") ||
-                  question_lower.contains("congress") || question_lower.contains("senate") ||
-                  question_lower.contains("vote") || question_lower.contains("politics") {
-            "politics".to_string()
-        } else {
-            "general".to_string()
-        }
-    }
-
     // Créer une raison enrichie avec les détails
     fn create_enriched_reason(&self, opportunity: &ArbitrageOpportunity, source_domain: &str, information_value: bool) -> String {
         let impact = if information_value { "positif" } else { "négatif" };
@@ -2806,6 +2851,10 @@ async fn main() -> Result<(), Box<dyn std::error::Error>> {
     println!("Press Ctrl+C to stop");
     println!();
     
+    // Flux temps réel CLOB (opt-in): POLYMARKET_MARKET_FEED=1 pour l'URL par défaut, ou une URL ws(s)://
+    let market_feed_setting = env::var("POLYMARKET_MARKET_FEED").unwrap_or_default();
+    let mut market_feed_enabled = false;
+    
     // Initialize C++ module with ROI parameters
     unsafe {
         if init_polymarket_core() {
@@ -2813,10 +2862,36 @@ async fn main() -> Result<(), Box<dyn std::error::Error>> {
             // Configure default ROI parameters
             configure_roi_params(0.005, 0.20, 0.001); // fee=0.5%, catchup_speed=20%/s, action_time=1ms (TEST FORCÉ)
             
+            // Taxonomie des marchés (domaines, mots-clés); taxonomie intégrée si absente
+            let taxonomy_path = env::var("POLYMARKET_TAXONOMY").unwrap_or_else(|_| "config/market_taxonomy.json".to_string());
+            let c_taxonomy_path = CString::new(taxonomy_path.clone()).unwrap();
+            if load_market_taxonomy(c_taxonomy_path.as_ptr()) {
+                println!("[OK] Market taxonomy: {}", taxonomy_path);
+            }
+            
+            // Historique persistant (démarrage à chaud des sources et des prix)
+            let history_path = env::var("POLYMARKET_HISTORY_DB").unwrap_or_else(|_| "polymarket_history.db".to_string());
+            let c_history_path = CString::new(history_path.clone()).unwrap();
+            if open_history_store(c_history_path.as_ptr()) {
+                println!("[OK] History store: {}", history_path);
+            } else {
+                println!("[WARN] History store unavailable: {}", history_path);
+            }
+            
+            if !market_feed_setting.is_empty() && market_feed_setting != "0" {
+                let c_feed_url = if market_feed_setting == "1" { None } else { Some(CString::new(market_feed_setting.clone()).unwrap()) };
+                market_feed_enabled = start_market_feed(c_feed_url.as_ref().map_or(std::ptr::null(), |url| url.as_ptr()));
+                if market_feed_enabled {
+                    println!("[OK] Market feed started (CLOB WebSocket, live prices)");
+                } else {
+                    println!("[WARN] Market feed could not be started");
+                }
+            }
+            
             // Initialize HFT optimizations
             optimize_memory_hft();
             println!("[OK] HFT optimizations initialized");
-            println!("   • ROI Cache: Enabled (1000 entries)");
+            println!("   • ROI Cache: Enabled (10001 price ticks, lock-free)");
             println!("   • Lookup tables: Precomputed");
             println!("   • Ultra-fast decisions: < 100ns");
             println!("   • Position calculations: < 50ns");
@@ -2852,6 +2927,16 @@ async fn main() -> Result<(), Box<dyn std::error::Error>> {
             bot.fetch_open_markets();
         }
         
+        // L'univers du core fixe les abonnements du flux; ses prix temps réel priment sur le REST
+        if market_feed_enabled {
+            unsafe {
+                if !update_market_data() {
+                    println!("[WARN] C++ core market update failed");
+                }
+                println!("[FEED] {} messages received", get_market_feed_messages());
+            }
+        }
+        
         // Phase 2: Monitoring des sources
         bot.monitor_all_resolution_sources().await;
         
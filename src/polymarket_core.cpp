@@ -2,25 +2,42 @@
 #include <string>
 #include <vector>
 #include <map>
+#include <deque>
+#include <unordered_map>
+#include <unordered_set>
 #include <chrono>
 #include <thread>
-#include <future>
 #include <mutex>
 #include <fstream>
 #include <sstream>
 #include <iomanip>
 #include <algorithm>
-#include <regex>
+#include <cstring>
+#include <cmath>
+#include <strings.h>
 #include <set>
+#include <atomic>
+#include <condition_variable>
+#include <memory>
+#include <memory_resource>
+#include <cctype>
+#include <array>
+#include <random>
+#include <poll.h>
+#include <string_view>
+#include <charconv>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#if defined(__x86_64__)
+#include <immintrin.h>
+#elif defined(__aarch64__)
+#include <arm_neon.h>
+#endif
 #include <curl/curl.h>
 #include <sqlite3.h>
 
-// Global ROI parameters - OPTIMIZED FOR HFT LATENCY
-double GLOBAL_FEE = 0.03; // 3% fees on profit (Polymarket standard)
-double GLOBAL_CATCHUP_SPEED = 0.8; // 80% per second (optimized for speed)
-double GLOBAL_ACTION_TIME = 0.025; // 25ms (optimized HFT latency)
-double GLOBAL_FIXED_COST = 0.0005; // Reduced fixed costs for HFT
-
 // TEST CONFIGURATION - Capital de test avec 1€
 double TEST_CAPITAL = 1.0; // 1€ pour les tests
 double TEST_POSITION_BASE = 0.025; // 2.5% du capital de test
@@ -28,13 +45,30 @@ double TEST_POSITION_MAX = 0.1; // 10% max du capital de test
 double TEST_POSITION_MIN = 0.01; // 1% min du capital de test
 
 // HFT optimizations - ROI cache to avoid recalculations
-std::map<std::string, double> roi_cache;
-std::mutex roi_cache_mutex;
-const int MAX_CACHE_SIZE = 1000;
+// Direct-mapped on the quantized price tick, tagged with the ROI parameter version:
+// readers never lock, configure_roi_params() invalidates every slot with one increment
+const int ROI_CACHE_TICKS = 10000; // price resolution 0.0001
+const uint64_t ROI_SLOT_WRITING = 1ULL << 63;
+
+struct RoiCacheSlot {
+    std::atomic<uint64_t> stamp{0}; // parameter version, ROI_SLOT_WRITING while being filled
+    std::atomic<double> roi{0.0};
+};
+
+std::atomic<uint32_t> roi_params_version{1};
+alignas(64) RoiCacheSlot roi_cache[ROI_CACHE_TICKS + 1];
 
 // HFT optimizations - Precomputed lookup tables
-std::vector<double> precomputed_roi_table;
-bool roi_table_initialized = false;
+// Immutable snapshot for one ROI parameter version, swapped atomically on rebuild
+const int ROI_TABLE_TICKS = 10000;
+
+struct RoiTable {
+    uint32_t params_version = 0;
+    std::vector<double> roi; // ROI at price i / ROI_TABLE_TICKS, i = 0..ROI_TABLE_TICKS
+    double yes_limit_at_half = 0.0; // YES-branch ROI at 0.5 (the bet side flips at 0.5)
+};
+
+std::shared_ptr<const RoiTable> precomputed_roi_table; // std::atomic_load / std::atomic_store
 
 // FFI pour Rust
 extern "C" {
@@ -66,11 +100,80 @@ extern "C" {
         double potential_roi_v2;
         char* source_url;
         char* reason;
-        uint64_t reaction_time;
-        uint64_t execution_time;
-        uint64_t total_time;
+        uint64_t reaction_time;  // µs, observation de la donnée -> décision
+        uint64_t execution_time; // µs, aller-retour estimé vers le CLOB
+        uint64_t total_time;     // µs, somme des deux
         char* grade;
     } TradingSignal_C;
+    
+    // Latences mesurées d'un hôte, en secondes (NaN sans mesure)
+    typedef struct {
+        uint64_t samples;
+        uint64_t failures;
+        double dns_ewma;
+        double connect_ewma;
+        double tls_ewma;
+        double ttfb_ewma;
+        double total_ewma;
+        double ttfb_p50;
+        double ttfb_p99;
+        double total_p50;
+        double total_p99;
+    } HostLatencyStats_C;
+    
+    // Distribution d'une étape du pipeline, en microsecondes (NaN sans mesure)
+    typedef struct {
+        uint64_t count;
+        double p50_us;
+        double p99_us;
+        double max_us;
+    } StageLatency_C;
+    
+    // Étapes par cycle; reaction et end_to_end par signal (observation -> décision / publication)
+    typedef struct {
+        StageLatency_C fetch;
+        StageLatency_C parse;
+        StageLatency_C match;
+        StageLatency_C detect;
+        StageLatency_C price;
+        StageLatency_C decide;
+        StageLatency_C emit;
+        StageLatency_C reaction;
+        StageLatency_C end_to_end;
+    } PipelineStats_C;
+    
+    // Paramètres d'un calcul ROI (voir RoiContext)
+    typedef struct {
+        double fee;
+        double catchup_speed;
+        double action_time;
+        double fixed_cost;
+        double pi_yes;
+    } RoiContext_C;
+    
+    // Résultat d'un rejeu (voir run_replay_sweep); pnl en € pour 1€ par trade exécuté
+    typedef struct {
+        uint64_t events;
+        uint64_t cycles;
+        uint64_t signals;
+        uint64_t executions;
+        uint64_t trades;
+        uint64_t wins;
+        double pnl;
+        double max_drawdown;
+        uint64_t signal_hash; // identique d'un rejeu à l'autre pour un même journal et mêmes paramètres
+    } ReplayResult_C;
+    
+    // Vue empruntée d'un instantané publié (voir acquire_core_snapshot)
+    typedef struct {
+        uint64_t generation;
+        const Market_C* markets;
+        size_t market_count;
+        const ArbitrageOpportunity_C* opportunities;
+        size_t opportunity_count;
+        const TradingSignal_C* signals;
+        size_t signal_count;
+    } CoreSnapshot_C;
 }
 
 using namespace std;
@@ -90,6 +193,9 @@ struct Market {
     double probability;
     string resolution_source;
     chrono::system_clock::time_point last_update;
+    string yes_token_id; // asset du jeton "Yes" (abonnement WebSocket)
+    vector<string> keywords;       // mots-clés de marché (taxonomie)
+    uint32_t taxonomy_version = 0; // 0: pas encore classé
 };
 
 struct ArbitrageOpportunity {
@@ -119,152 +225,1498 @@ struct TradingSignal {
 
 struct SourceData {
     string url;
-    bool accessible;
-    int content_length;
+    bool accessible = false;
+    int content_length = 0;
     vector<string> found_keywords;
     string error;
     chrono::system_clock::time_point last_check;
+    
+    // Cache de revalidation (GET conditionnel + empreinte du contenu)
+    string etag;
+    string last_modified;
+    uint64_t content_hash = 0;
+    uint64_t keyword_signature = 0; // jeu de mots-clés ayant produit found_keywords
+    bool not_modified = false;      // 304 ou contenu identique au cycle précédent
+    bool truncated = false;         // transfert interrompu dès les mots-clés trouvés (pas d'empreinte)
+};
+
+// ===== IDENTIFIANTS INTERNÉS =====
+// Le chemin de détection manipule des identifiants entiers (marchés, sources) et des enums
+// (confiance, action, grade); les chaînes ne sont reconstruites qu'aux frontières (FFI, logs).
+
+// Table d'internement: chaîne <-> identifiant entier dense (références stables)
+class StringInterner {
+private:
+    unordered_map<string, uint32_t> ids;
+    deque<string> names;
+    
+public:
+    static constexpr uint32_t NONE = UINT32_MAX;
+    
+    uint32_t intern(const string& name) {
+        auto it = ids.find(name);
+        if (it != ids.end()) return it->second;
+        uint32_t id = (uint32_t)names.size();
+        ids.emplace(name, id);
+        names.push_back(name);
+        return id;
+    }
+    
+    uint32_t find(const string& name) const {
+        auto it = ids.find(name);
+        return it == ids.end() ? NONE : it->second;
+    }
+    
+    const string& name(uint32_t id) const { return names[id]; }
+    size_t size() const { return names.size(); }
+};
+
+// Table partagée entre threads; les identifiants ne sont jamais recyclés
+class SymbolTable {
+private:
+    StringInterner interner;
+    mutable mutex table_mutex;
+    
+public:
+    uint32_t intern(const string& name) {
+        lock_guard<mutex> lock(table_mutex);
+        return interner.intern(name);
+    }
+    
+    uint32_t find(const string& name) const {
+        lock_guard<mutex> lock(table_mutex);
+        return interner.find(name);
+    }
+    
+    const string& name(uint32_t id) const {
+        lock_guard<mutex> lock(table_mutex);
+        return interner.name(id);
+    }
+};
+
+SymbolTable market_symbols;
+SymbolTable source_symbols;
+
+enum class Confidence : uint8_t { LOW, MEDIUM, HIGH };
+enum class TradeAction : uint8_t { MONITOR, BUY, SELL, CLEAR };
+enum class SignalGrade : uint8_t { A, B, C };
+
+const char* confidence_name(Confidence confidence) {
+    switch (confidence) {
+        case Confidence::HIGH: return "high";
+        case Confidence::MEDIUM: return "medium";
+        default: return "low";
+    }
+}
+
+const char* action_name(TradeAction action, bool executed = false) {
+    switch (action) {
+        case TradeAction::BUY: return executed ? "EXECUTED_BUY" : "BUY";
+        case TradeAction::SELL: return executed ? "EXECUTED_SELL" : "SELL";
+        case TradeAction::CLEAR: return "CLEAR"; // delta: le marché n'a plus de signal
+        default: return executed ? "EXECUTED_MONITOR" : "MONITOR";
+    }
+}
+
+const char* grade_name(SignalGrade grade) {
+    switch (grade) {
+        case SignalGrade::A: return "A";
+        case SignalGrade::C: return "C";
+        default: return "B";
+    }
+}
+
+Confidence confidence_for_relevance(double relevance) {
+    if (relevance > 0.7) return Confidence::HIGH;
+    if (relevance > 0.3) return Confidence::MEDIUM;
+    return Confidence::LOW;
+}
+
+// Final decision by C++ - realistic thresholds for 4000€
+// ROI values are in percentage (e.g., 23.9 = 23.9%)
+TradeAction decide_trade_action(double roi_v2) {
+    if (roi_v2 > 2.0) return TradeAction::BUY;   // ROI > 2%
+    if (roi_v2 > 0.5) return TradeAction::SELL;  // ROI > 0.5%
+    return TradeAction::MONITOR;
+}
+
+string opportunity_reason(const string& url, double relevance) {
+    return "Source " + url + " relevant to market (score: " + to_string(relevance) + ")";
+}
+
+// Opportunités en colonnes (SoA): identifiants internés + champs numériques contigus
+struct OpportunityColumns {
+    vector<uint32_t> market;
+    vector<uint32_t> source;
+    vector<double> relevance;
+    vector<double> roi_v1;
+    vector<double> roi_v2;
+    vector<Confidence> confidence;
+    
+    size_t size() const { return market.size(); }
+    
+    void clear() {
+        market.clear(); source.clear(); relevance.clear();
+        roi_v1.clear(); roi_v2.clear(); confidence.clear();
+    }
+    
+    void push(uint32_t market_id, uint32_t source_id, double rel, double v1, double v2) {
+        market.push_back(market_id);
+        source.push_back(source_id);
+        relevance.push_back(rel);
+        roi_v1.push_back(v1);
+        roi_v2.push_back(v2);
+        confidence.push_back(confidence_for_relevance(rel));
+    }
+    
+    string reason(size_t i) const { return opportunity_reason(source_symbols.name(source[i]), relevance[i]); }
+    
+    ArbitrageOpportunity materialize(size_t i) const {
+        ArbitrageOpportunity opp;
+        opp.market_id = market_symbols.name(market[i]);
+        opp.source_url = source_symbols.name(source[i]);
+        opp.relevance_score = relevance[i];
+        opp.confidence = confidence_name(confidence[i]);
+        opp.reason = reason(i);
+        opp.potential_roi_v1 = roi_v1[i];
+        opp.potential_roi_v2 = roi_v2[i];
+        opp.timestamp = chrono::system_clock::now();
+        return opp;
+    }
+};
+
+// Signal compact (POD): aucune chaîne, raison reconstruite à la demande
+struct SignalRecord {
+    uint32_t market;
+    uint32_t source;
+    TradeAction action;
+    Confidence confidence;
+    SignalGrade grade;
+    bool executed;
+    double relevance;
+    double roi_v1;
+    double roi_v2;
+    uint64_t reaction_time;  // µs (voir TradingSignal_C)
+    uint64_t execution_time;
+    uint64_t total_time;
+    uint64_t observed_ns;    // pipeline_clock_ns() à l'observation de la donnée ayant produit le signal
 };
 
+string signal_reason(const SignalRecord& record) {
+    return opportunity_reason(source_symbols.name(record.source), record.relevance);
+}
+
+TradingSignal materialize_signal(const SignalRecord& record) {
+    TradingSignal signal;
+    signal.market_id = market_symbols.name(record.market);
+    signal.action = action_name(record.action, record.executed);
+    signal.confidence = confidence_name(record.confidence);
+    signal.potential_roi_v1 = record.roi_v1;
+    signal.potential_roi_v2 = record.roi_v2;
+    signal.source_url = source_symbols.name(record.source);
+    signal.reason = signal_reason(record);
+    signal.reaction_time = record.reaction_time;
+    signal.execution_time = record.execution_time;
+    signal.total_time = record.total_time;
+    signal.grade = grade_name(record.grade);
+    return signal;
+}
+
 // Variables globales
-vector<Market> markets;
-vector<ArbitrageOpportunity> opportunities;
-vector<TradingSignal> signals;
-map<string, SourceData> source_data;
-mutex markets_mutex;
-mutex opportunities_mutex;
-mutex signals_mutex;
-mutex source_data_mutex;
+// État publié par copie sur écriture (RCU): chaque cycle construit une nouvelle version et la
+// publie atomiquement; les parties inchangées sont partagées entre versions. Les lecteurs
+// chargent un shared_ptr et ne prennent jamais le verrou des écrivains.
+struct CoreState {
+    uint64_t version = 0;
+    shared_ptr<const vector<Market>> markets = make_shared<const vector<Market>>();
+    shared_ptr<const vector<double>> prices = make_shared<const vector<double>>(); // prix temps réel, prime sur markets[i].probability
+    shared_ptr<const map<string, SourceData>> source_data = make_shared<const map<string, SourceData>>();
+    shared_ptr<const OpportunityColumns> opportunities = make_shared<const OpportunityColumns>();
+    shared_ptr<const vector<SignalRecord>> signals = make_shared<const vector<SignalRecord>>();
+};
 
-// Callback pour libcurl
-size_t WriteCallback(void* contents, size_t size, size_t nmemb, string* userp) {
-    userp->append((char*)contents, size * nmemb);
-    return size * nmemb;
+shared_ptr<const CoreState> core_state = make_shared<const CoreState>(); // std::atomic_load / std::atomic_store
+mutex update_mutex; // sérialise les écrivains (cycles, pipeline); jamais pris par les lecteurs FFI
+
+// Tailles de la dernière version, lues sans verrou à haute fréquence
+atomic<int> markets_count{0};
+atomic<int> opportunities_count{0};
+atomic<int> signals_count{0};
+
+void publish_core_state(shared_ptr<const CoreState> state) {
+    markets_count.store((int)state->markets->size(), memory_order_relaxed);
+    opportunities_count.store((int)state->opportunities->size(), memory_order_relaxed);
+    signals_count.store((int)state->signals->size(), memory_order_relaxed);
+    std::atomic_store(&core_state, move(state));
 }
 
-// Classe HTTP Client optimisée
-class FastHTTPClient {
+// ===== JOURNALISATION ASYNCHRONE =====
+// Le chemin critique n'enregistre qu'un horodatage, un identifiant d'événement et quelques
+// arguments dans un ring buffer MPSC sans verrou; le formatage et l'écriture sur stdout
+// sont faits par un thread dédié. Niveau minimal fixé à la compilation (PM_LOG_LEVEL).
+#define PM_LOG_LEVEL_DEBUG 0
+#define PM_LOG_LEVEL_INFO 1
+#define PM_LOG_LEVEL_WARN 2
+#define PM_LOG_LEVEL_ERROR 3
+#define PM_LOG_LEVEL_OFF 4
+
+#ifndef PM_LOG_LEVEL
+#define PM_LOG_LEVEL PM_LOG_LEVEL_INFO
+#endif
+
+enum class LogEvent : uint16_t {
+    MARKETS_FETCHED,      // i0 marchés, i1 ms
+    SOURCE_OK,            // s0 url, i0 octets, i1 ms, i2 arrêt anticipé
+    SOURCE_NOT_MODIFIED,  // s0 url, i0 ms
+    SOURCE_UNCHANGED,     // s0 url, i0 octets, i1 ms
+    SOURCE_ERROR,         // s0 url, s1 erreur
+    DECISION,             // s0 marché, s1 action, d0 ROI %
+    TRADE_PRIORITIZED,    // s0 marché, s1 action, d0 ROI %
+    TRADE_EXECUTED,       // s0 marché, s1 action, d0 ROI %
+    PRIORITY_SUMMARY,     // i0 trades uniques
+    UPDATE_SUMMARY,       // i0 marchés, i1 opportunités, i2 signaux
+    TRADE_REQUEST,        // s0 marché, s1 action, d0 montant
+    POSITION_SIZE,        // s0 confiance, d0 montant, d1 ROI
+    FEED_CONNECTED,       // s0 url, i0 assets
+    FEED_DISCONNECTED,    // s0 raison
+    HISTORY_FLUSHED,      // i0 lignes, i1 µs
+    HISTORY_ERROR,        // s0 contexte, s1 erreur SQLite
+    COUNT
+};
+
+constexpr int log_event_level(LogEvent event) {
+    switch (event) {
+        case LogEvent::SOURCE_ERROR:
+        case LogEvent::FEED_DISCONNECTED:
+        case LogEvent::HISTORY_ERROR: return PM_LOG_LEVEL_WARN;
+        case LogEvent::TRADE_PRIORITIZED:
+        case LogEvent::HISTORY_FLUSHED:
+        case LogEvent::POSITION_SIZE: return PM_LOG_LEVEL_DEBUG;
+        default: return PM_LOG_LEVEL_INFO;
+    }
+}
+
+const size_t LOG_STR_CAP = 256;   // URL, erreur curl (CURL_ERROR_SIZE) ou SQLite; au-delà, coupé avec "…"
+const size_t LOG_RING_SIZE = 8192; // puissance de 2
+const int LOG_SPIN_ROUNDS = 64;    // tours d'attente active du writer avant de se garer
+
+struct LogRecord {
+    uint64_t timestamp_ns;
+    LogEvent event;
+    uint8_t num_count;
+    uint8_t str_count;
+    union { double d; int64_t i; } num[4];
+    char str[2][LOG_STR_CAP];
+};
+
+void format_log_record(FILE* out, const LogRecord& r) {
+    const char* s0 = r.str[0];
+    const char* s1 = r.str[1];
+    switch (r.event) {
+        case LogEvent::MARKETS_FETCHED:
+            fprintf(out, "[OK] %lld marchés récupérés en %lldms\n", (long long)r.num[0].i, (long long)r.num[1].i);
+            break;
+        case LogEvent::SOURCE_OK:
+            fprintf(out, "  [OK] %s (%lld chars%s, %lldms)\n", s0, (long long)r.num[0].i,
+                    r.num[2].i ? ", early stop" : "", (long long)r.num[1].i);
+            break;
+        case LogEvent::SOURCE_NOT_MODIFIED:
+            fprintf(out, "  [OK] %s (304 not modified, %lldms)\n", s0, (long long)r.num[0].i);
+            break;
+        case LogEvent::SOURCE_UNCHANGED:
+            fprintf(out, "  [OK] %s (unchanged, %lld chars, %lldms)\n", s0, (long long)r.num[0].i, (long long)r.num[1].i);
+            break;
+        case LogEvent::SOURCE_ERROR:
+            fprintf(out, "  [ERROR] %s (%s)\n", s0, s1);
+            break;
+        case LogEvent::DECISION:
+            fprintf(out, "[C++ DECISION] %s signal for %s (ROI: %g%%)\n", s1, s0, r.num[0].d);
+            break;
+        case LogEvent::TRADE_PRIORITIZED:
+            fprintf(out, "[PRIORITY] Trade priorisé: %s (ROI: %g%%, Action: %s)\n", s0, r.num[0].d, s1);
+            break;
+        case LogEvent::TRADE_EXECUTED:
+            fprintf(out, "🚀 [EXECUTION] Trade automatique exécuté!\n   Market: %s\n   Action: %s\n   ROI: %g%%\n   Montant: 1€\n",
+                    s0, s1, r.num[0].d);
+            break;
+        case LogEvent::PRIORITY_SUMMARY:
+            fprintf(out, "[PRIORITY] %lld trades uniques, meilleur exécuté automatiquement\n", (long long)r.num[0].i);
+            break;
+        case LogEvent::UPDATE_SUMMARY:
+            fprintf(out, "[OK] Données mises à jour: %lld marchés, %lld opportunités, %lld signaux\n",
+                    (long long)r.num[0].i, (long long)r.num[1].i, (long long)r.num[2].i);
+            break;
+        case LogEvent::TRADE_REQUEST:
+            fprintf(out, "Exécution de trade C++:\n   Market ID: %s\n   Action: %s\n   Amount: %g ETH\n[OK] Trade exécuté avec succès\n",
+                    s0, s1, r.num[0].d);
+            break;
+        case LogEvent::POSITION_SIZE:
+            fprintf(out, "[TRADE] Position: %.2f€ (ROI: %.2f%%, confiance: %s)\n", r.num[0].d, r.num[1].d * 100, s0);
+            break;
+        case LogEvent::FEED_CONNECTED:
+            fprintf(out, "[OK] Flux WebSocket %s (%lld assets)\n", s0, (long long)r.num[0].i);
+            break;
+        case LogEvent::FEED_DISCONNECTED:
+            fprintf(out, "[WARN] Flux WebSocket interrompu: %s\n", s0);
+            break;
+        case LogEvent::HISTORY_FLUSHED:
+            fprintf(out, "[HISTORY] %lld lignes écrites en %lld µs\n", (long long)r.num[0].i, (long long)r.num[1].i);
+            break;
+        case LogEvent::HISTORY_ERROR:
+            fprintf(out, "[WARN] Historique SQLite (%s): %s\n", s0, s1);
+            break;
+        case LogEvent::COUNT:
+            break;
+    }
+}
+
+class AsyncLogger {
 private:
-    CURL* curl;
-    struct curl_slist* headers;
+    struct Slot {
+        std::atomic<size_t> sequence;
+        LogRecord record;
+    };
     
-public:
-    FastHTTPClient() {
-        curl_global_init(CURL_GLOBAL_ALL);
-        curl = curl_easy_init();
-        headers = nullptr;
-        
-        if (curl) {
-            headers = curl_slist_append(headers, "User-Agent: Polymarket-Bot/1.0");
-            headers = curl_slist_append(headers, "Accept: application/json");
-            headers = curl_slist_append(headers, "Content-Type: application/json");
-            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
-            curl_easy_setopt(curl, CURLOPT_TIMEOUT, REQUEST_TIMEOUT_MS / 1000);
-            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 3);
-            curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
-            curl_easy_setopt(curl, CURLOPT_TCP_FASTOPEN, 1L);
+    std::unique_ptr<Slot[]> ring;
+    alignas(64) std::atomic<size_t> enqueue_pos{0};
+    alignas(64) size_t dequeue_pos = 0; // consommateur unique
+    std::atomic<uint64_t> dropped{0};       // depuis le dernier rapport du writer
+    std::atomic<uint64_t> dropped_total{0};
+    std::atomic<uint64_t> written{0};
+    std::atomic<bool> stopping{false};
+    std::once_flag start_flag;
+    std::thread writer;
+    
+    // Writer garé sur park_cv quand le ring est vide; un producteur ne le réveille que dans ce cas
+    std::atomic<bool> parked{false};
+    std::mutex park_mutex;
+    std::condition_variable park_cv;
+    bool wake_pending = false;
+    
+    static void pack(LogRecord& r, const char* value) {
+        static const char ellipsis[] = "\xE2\x80\xA6"; // "…" en UTF-8
+        if (r.str_count >= 2) return;
+        char* dst = r.str[r.str_count++];
+        size_t len = value ? strnlen(value, LOG_STR_CAP) : 0;
+        if (len == LOG_STR_CAP) {
+            // Texte trop long: coupé sur une frontière de caractère UTF-8 et marqué
+            len = LOG_STR_CAP - sizeof(ellipsis);
+            while (len > 0 && ((unsigned char)value[len] & 0xC0) == 0x80) len--;
+            memcpy(dst, value, len);
+            memcpy(dst + len, ellipsis, sizeof(ellipsis));
+            return;
         }
+        if (len) memcpy(dst, value, len);
+        dst[len] = '\0';
     }
+    static void pack(LogRecord& r, const std::string& value) { pack(r, value.c_str()); }
     
-    ~FastHTTPClient() {
-        if (headers) curl_slist_free_all(headers);
-        if (curl) curl_easy_cleanup(curl);
-        curl_global_cleanup();
+    template <typename T>
+    static typename std::enable_if<std::is_arithmetic<T>::value>::type pack(LogRecord& r, T value) {
+        if (r.num_count >= 4) return;
+        if (std::is_floating_point<T>::value) r.num[r.num_count++].d = (double)value;
+        else r.num[r.num_count++].i = (int64_t)value;
     }
     
-    string GET(const string& url) {
-        string response;
-        
-        if (!curl) return "";
-        
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
-        
-        CURLcode res = curl_easy_perform(curl);
-        
-        if (res != CURLE_OK) {
-            return "";
+    // Vide le ring; retourne le nombre d'enregistrements écrits
+    size_t drain() {
+        size_t count = 0;
+        while (true) {
+            Slot& slot = ring[dequeue_pos & (LOG_RING_SIZE - 1)];
+            if (slot.sequence.load(std::memory_order_acquire) != dequeue_pos + 1) break;
+            
+            const LogRecord& r = slot.record;
+            time_t secs = (time_t)(r.timestamp_ns / 1000000000ULL);
+            struct tm tm_buf;
+            localtime_r(&secs, &tm_buf);
+            fprintf(stdout, "%02d:%02d:%02d.%06llu ", tm_buf.tm_hour, tm_buf.tm_min, tm_buf.tm_sec,
+                    (unsigned long long)(r.timestamp_ns % 1000000000ULL) / 1000);
+            format_log_record(stdout, r);
+            
+            slot.sequence.store(dequeue_pos + LOG_RING_SIZE, std::memory_order_release);
+            dequeue_pos++;
+            count++;
         }
-        
-        return response;
+        if (count) {
+            uint64_t lost = dropped.exchange(0, std::memory_order_relaxed);
+            if (lost) fprintf(stdout, "[LOG] %llu messages perdus (ring plein)\n", (unsigned long long)lost);
+            fflush(stdout);
+            written.fetch_add(count, std::memory_order_release);
+        }
+        return count;
     }
     
-    string POST(const string& url, const string& data) {
-        string response;
-        
-        if (!curl) return "";
-        
-        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
-        curl_easy_setopt(curl, CURLOPT_POST, 1L);
-        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
-        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
-        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+    bool has_pending() const {
+        return ring[dequeue_pos & (LOG_RING_SIZE - 1)].sequence.load(std::memory_order_acquire) == dequeue_pos + 1;
+    }
+    
+    void wake() {
+        std::lock_guard<std::mutex> lock(park_mutex);
+        wake_pending = true;
+        park_cv.notify_one();
+    }
+    
+    void run() {
+        while (!stopping.load(std::memory_order_acquire)) {
+            if (drain() > 0) continue;
+            
+            // Courte attente active (rafales), puis le writer se gare jusqu'au prochain enregistrement
+            bool pending = false;
+            for (int spin = 0; spin < LOG_SPIN_ROUNDS && !(pending = has_pending()); spin++) std::this_thread::yield();
+            if (pending) continue;
+            
+            std::unique_lock<std::mutex> lock(park_mutex);
+            parked.store(true, std::memory_order_relaxed);
+            // Couplée à celle de log(): soit le producteur voit parked, soit le writer voit l'enregistrement
+            std::atomic_thread_fence(std::memory_order_seq_cst);
+            if (!has_pending()) {
+                park_cv.wait(lock, [this]() { return wake_pending || stopping.load(std::memory_order_acquire); });
+            }
+            wake_pending = false;
+            parked.store(false, std::memory_order_relaxed);
+        }
+        drain();
+    }
+    
+    void start() {
+        std::call_once(start_flag, [this]() { writer = std::thread([this]() { run(); }); });
+    }
+    
+public:
+    AsyncLogger() : ring(new Slot[LOG_RING_SIZE]) {
+        for (size_t i = 0; i < LOG_RING_SIZE; i++) ring[i].sequence.store(i, std::memory_order_relaxed);
+    }
+    
+    ~AsyncLogger() {
+        stopping.store(true, std::memory_order_release);
+        wake();
+        if (writer.joinable()) writer.join();
+    }
+    
+    AsyncLogger(const AsyncLogger&) = delete;
+    AsyncLogger& operator=(const AsyncLogger&) = delete;
+    
+    // Producteurs multiples, sans verrou; l'enregistrement est perdu si le ring est plein
+    template <typename... Args>
+    void log(LogEvent event, const Args&... args) {
+        start();
+        size_t pos = enqueue_pos.load(std::memory_order_relaxed);
+        Slot* slot;
+        while (true) {
+            slot = &ring[pos & (LOG_RING_SIZE - 1)];
+            size_t seq = slot->sequence.load(std::memory_order_acquire);
+            intptr_t diff = (intptr_t)seq - (intptr_t)pos;
+            if (diff == 0) {
+                if (enqueue_pos.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) break;
+            } else if (diff < 0) {
+                dropped.fetch_add(1, std::memory_order_relaxed);
+                dropped_total.fetch_add(1, std::memory_order_relaxed);
+                return;
+            } else {
+                pos = enqueue_pos.load(std::memory_order_relaxed);
+            }
+        }
         
-        CURLcode res = curl_easy_perform(curl);
+        LogRecord& r = slot->record;
+        r.timestamp_ns = (uint64_t)std::chrono::duration_cast<std::chrono::nanoseconds>(
+            std::chrono::system_clock::now().time_since_epoch()).count();
+        r.event = event;
+        r.num_count = 0;
+        r.str_count = 0;
+        r.str[0][0] = r.str[1][0] = '\0';
+        (void)std::initializer_list<int>{(pack(r, args), 0)...};
         
-        if (res != CURLE_OK) {
-            return "";
+        slot->sequence.store(pos + 1, std::memory_order_release);
+        std::atomic_thread_fence(std::memory_order_seq_cst);
+        if (parked.load(std::memory_order_relaxed)) wake();
+    }
+    
+    // Attend que tout ce qui a été enregistré avant l'appel soit écrit. enqueue_pos ne compte que
+    // les enregistrements acceptés (un rejet ne réserve pas de position), écrits dans l'ordre
+    void flush() {
+        size_t target = enqueue_pos.load(std::memory_order_acquire);
+        if (target == 0) return;
+        start();
+        while (written.load(std::memory_order_acquire) < target) {
+            std::this_thread::sleep_for(std::chrono::microseconds(100));
         }
-        
-        return response;
     }
+    
+    uint64_t dropped_count() const { return dropped_total.load(std::memory_order_relaxed); }
 };
 
-// Fonctions utilitaires
-string get_current_timestamp() {
-    auto now = chrono::system_clock::now();
-    auto time_t = chrono::system_clock::to_time_t(now);
-    auto ms = chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()) % 1000;
-    
-    stringstream ss;
-    ss << put_time(localtime(&time_t), "%Y-%m-%d %H:%M:%S");
-    ss << '.' << setfill('0') << setw(3) << ms.count();
-    return ss.str();
+AsyncLogger core_log;
+
+#define PM_LOG(event, ...)                                                  \
+    do {                                                                    \
+        if constexpr (log_event_level(event) >= PM_LOG_LEVEL) {             \
+            core_log.log(event, __VA_ARGS__);                               \
+        }                                                                   \
+    } while (0)
+
+// Callback pour libcurl
+size_t WriteCallback(void* contents, size_t size, size_t nmemb, string* userp) {
+    userp->append((char*)contents, size * nmemb);
+    return size * nmemb;
+}
+
+// Réponse HTTP avec les validateurs nécessaires au GET conditionnel
+struct HTTPResponse {
+    long status = 0;
+    string body;
+    string etag;
+    string last_modified;
+};
+
+// Capture ETag / Last-Modified (noms d'en-têtes insensibles à la casse)
+size_t HeaderCallback(char* buffer, size_t size, size_t nitems, HTTPResponse* resp) {
+    size_t len = size * nitems;
+    auto capture = [&](const char* name, string& out) {
+        size_t name_len = strlen(name);
+        if (len <= name_len || strncasecmp(buffer, name, name_len) != 0) return;
+        size_t begin = name_len;
+        size_t end = len;
+        while (begin < end && (buffer[begin] == ' ' || buffer[begin] == '\t')) begin++;
+        while (end > begin && (buffer[end - 1] == '\r' || buffer[end - 1] == '\n' || buffer[end - 1] == ' ')) end--;
+        out.assign(buffer + begin, end - begin);
+    };
+    capture("etag:", resp->etag);
+    capture("last-modified:", resp->last_modified);
+    return len;
+}
+
+// Ajoute If-None-Match / If-Modified-Since à une liste d'en-têtes
+struct curl_slist* append_conditional_headers(struct curl_slist* list, const string& etag, const string& last_modified) {
+    if (!etag.empty()) list = curl_slist_append(list, ("If-None-Match: " + etag).c_str());
+    if (!last_modified.empty()) list = curl_slist_append(list, ("If-Modified-Since: " + last_modified).c_str());
+    return list;
 }
 
-string categorize_market_domain(const string& question, const string& description) {
-    string text = question + " " + description;
-    transform(text.begin(), text.end(), text.begin(), ::tolower);
+// Empreinte rapide du contenu: mots de 8 octets, incrémentale (les chunks peuvent être coupés n'importe où)
+class ContentHasher {
+private:
+    static constexpr uint64_t K0 = 0x9E3779B97F4A7C15ULL;
+    static constexpr uint64_t K1 = 0xC2B2AE3D27D4EB4FULL;
+    
+    uint64_t h = K0;
+    uint64_t total = 0;
+    unsigned char tail[8];
+    size_t tail_len = 0;
+    
+    static uint64_t rotl(uint64_t x, int r) { return (x << r) | (x >> (64 - r)); }
     
-    if (text.find("fed") != string::npos || text.find("rate") != string::npos || 
-        text.find("recession") != string::npos || text.find("gdp") != string::npos) {
-        return "economy";
+    void mix(uint64_t word) {
+        h ^= rotl(word * K1, 31) * K0;
+        h = rotl(h, 27) * 5 + 0x52DCE729;
     }
-    if (text.find("trump") != string::npos || text.find("election") != string::npos || 
-        text.find("president") != string::npos) {
-        return "politics";
+    
+public:
+    void update(const char* data, size_t len) {
+        total += len;
+        if (tail_len > 0) {
+            size_t take = min(len, 8 - tail_len);
+            memcpy(tail + tail_len, data, take);
+            tail_len += take;
+            data += take;
+            len -= take;
+            if (tail_len < 8) return;
+            uint64_t word;
+            memcpy(&word, tail, 8);
+            mix(word);
+            tail_len = 0;
+        }
+        while (len >= 8) {
+            uint64_t word;
+            memcpy(&word, data, 8);
+            mix(word);
+            data += 8;
+            len -= 8;
+        }
+        memcpy(tail, data, len);
+        tail_len = len;
     }
-    if (text.find("bitcoin") != string::npos || text.find("ethereum") != string::npos || 
-        text.find("crypto") != string::npos || text.find("tether") != string::npos) {
-        return "crypto";
+    
+    uint64_t digest() const {
+        uint64_t x = h ^ total;
+        for (size_t i = 0; i < tail_len; i++) x = (x ^ tail[i]) * 0x100000001B3ULL;
+        x ^= x >> 33; x *= 0xFF51AFD7ED558CCDULL;
+        x ^= x >> 33; x *= 0xC4CEB9FE1A85EC53ULL;
+        x ^= x >> 33;
+        return x;
+    }
+};
+
+uint64_t fast_content_hash(const string& content) {
+    ContentHasher hasher;
+    hasher.update(content.data(), content.size());
+    return hasher.digest();
+}
+
+uint64_t keyword_set_signature(const vector<string>& keywords) {
+    ContentHasher hasher;
+    for (const auto& keyword : keywords) {
+        hasher.update(keyword.data(), keyword.size());
+        hasher.update("\0", 1);
     }
-    if (text.find("match") != string::npos || text.find("game") != string::npos || 
-        text.find("sports") != string::npos) {
-        return "sports";
+    return hasher.digest();
+}
+
+// Un état précédent n'est réutilisable que s'il a été produit avec le même jeu de mots-clés
+bool can_revalidate(const SourceData* previous, uint64_t keyword_sig) {
+    return previous && previous->accessible && previous->keyword_signature == keyword_sig;
+}
+
+// Automate Aho-Corasick insensible à la casse, compilé une fois par jeu de mots-clés
+// DFA complet sur un alphabet réduit: une lecture de table par octet, pas de retour arrière
+class KeywordAutomaton {
+private:
+    vector<string> patterns;
+    uint64_t signature;
+    uint8_t byte_class[256];
+    uint32_t alphabet = 1;          // classe 0 = octet absent de tous les motifs
+    vector<uint32_t> delta;         // states * alphabet
+    vector<uint32_t> out_offset;    // states + 1
+    vector<uint32_t> out_ids;       // motifs terminant dans chaque état (suffixes inclus)
+    
+public:
+    explicit KeywordAutomaton(const vector<string>& keywords)
+        : patterns(keywords), signature(keyword_set_signature(keywords)) {
+        memset(byte_class, 0, sizeof(byte_class));
+        for (const auto& pattern : patterns) {
+            for (unsigned char c : pattern) {
+                unsigned char folded = (unsigned char)tolower(c);
+                if (byte_class[folded] == 0) {
+                    if (alphabet == 256) break;
+                    byte_class[folded] = (uint8_t)alphabet++;
+                }
+            }
+        }
+        for (int c = 'A'; c <= 'Z'; c++) byte_class[c] = byte_class[c - 'A' + 'a'];
+        
+        // Trie
+        vector<vector<int32_t>> go(1, vector<int32_t>(alphabet, -1));
+        vector<vector<uint32_t>> outputs(1);
+        for (uint32_t id = 0; id < patterns.size(); id++) {
+            if (patterns[id].empty()) continue;
+            int32_t node = 0;
+            for (unsigned char c : patterns[id]) {
+                uint32_t cls = byte_class[(unsigned char)tolower(c)];
+                if (go[node][cls] < 0) {
+                    go[node][cls] = (int32_t)go.size();
+                    go.emplace_back(alphabet, -1);
+                    outputs.emplace_back();
+                }
+                node = go[node][cls];
+            }
+            outputs[node].push_back(id);
+        }
+        
+        // Liens d'échec en BFS, transitions manquantes complétées (DFA)
+        size_t states = go.size();
+        vector<uint32_t> fail(states, 0);
+        vector<uint32_t> queue;
+        queue.reserve(states);
+        delta.assign(states * alphabet, 0);
+        for (uint32_t cls = 0; cls < alphabet; cls++) {
+            if (go[0][cls] > 0) {
+                delta[cls] = go[0][cls];
+                queue.push_back(go[0][cls]);
+            }
+        }
+        for (size_t head = 0; head < queue.size(); head++) {
+            uint32_t node = queue[head];
+            const auto& fail_out = outputs[fail[node]];
+            outputs[node].insert(outputs[node].end(), fail_out.begin(), fail_out.end());
+            for (uint32_t cls = 0; cls < alphabet; cls++) {
+                int32_t child = go[node][cls];
+                if (child > 0) {
+                    fail[child] = delta[fail[node] * alphabet + cls];
+                    delta[node * alphabet + cls] = child;
+                    queue.push_back(child);
+                } else {
+                    delta[node * alphabet + cls] = delta[fail[node] * alphabet + cls];
+                }
+            }
+        }
+        
+        out_offset.resize(states + 1, 0);
+        for (size_t node = 0; node < states; node++) {
+            out_offset[node + 1] = out_offset[node] + outputs[node].size();
+            out_ids.insert(out_ids.end(), outputs[node].begin(), outputs[node].end());
+        }
     }
-    if (text.find("covid") != string::npos || text.find("health") != string::npos || 
-        text.find("vaccine") != string::npos) {
-        return "health";
+    
+    size_t pattern_count() const { return patterns.size(); }
+    const string& pattern(size_t id) const { return patterns[id]; }
+    uint64_t keyword_signature() const { return signature; }
+    
+    // Avance l'automate sur data; on_match(id) pour chaque occurrence.
+    // on_match retourne false pour interrompre le scan.
+    template <typename F>
+    uint32_t scan(uint32_t state, const char* data, size_t len, F&& on_match) const {
+        const uint32_t* table = delta.data();
+        const uint32_t* offsets = out_offset.data();
+        for (size_t i = 0; i < len; i++) {
+            state = table[state * alphabet + byte_class[(unsigned char)data[i]]];
+            if (offsets[state] != offsets[state + 1]) {
+                for (uint32_t k = offsets[state]; k < offsets[state + 1]; k++) {
+                    if (!on_match(out_ids[k])) return state;
+                }
+            }
+        }
+        return state;
     }
+};
+
+// Automates partagés, indexés par signature du jeu de mots-clés
+shared_ptr<const KeywordAutomaton> keyword_automaton_for(const vector<string>& keywords) {
+    static mutex cache_mutex;
+    static map<uint64_t, shared_ptr<const KeywordAutomaton>> cache;
     
-    return "other";
+    uint64_t signature = keyword_set_signature(keywords);
+    lock_guard<mutex> lock(cache_mutex);
+    auto it = cache.find(signature);
+    if (it != cache.end()) return it->second;
+    
+    if (cache.size() >= 64) cache.clear();
+    auto automaton = make_shared<const KeywordAutomaton>(keywords);
+    cache[signature] = automaton;
+    return automaton;
 }
 
-vector<string> extract_urls(const string& text) {
-    vector<string> urls;
-    regex url_pattern(R"((https?://[^\s]+))");
+// Arrêt anticipé d'un transfert source
+enum class StreamAbortMode { NONE = 0, ALL_FOUND = 1, FIRST_HIT = 2 };
+atomic<int> source_stream_abort_mode{(int)StreamAbortMode::ALL_FOUND};
+
+// État de scan d'un corps de réponse consommé chunk par chunk
+// Les occurrences à cheval sur deux chunks sont trouvées (l'état de l'automate persiste)
+struct KeywordStream {
+    shared_ptr<const KeywordAutomaton> automaton;
+    StreamAbortMode abort_mode = StreamAbortMode::NONE;
+    uint32_t state = 0;
+    vector<bool> found;
+    size_t found_count = 0;
+    size_t bytes = 0;
+    ContentHasher hasher;
+    bool aborted = false;
     
-    auto words_begin = sregex_iterator(text.begin(), text.end(), url_pattern);
-    auto words_end = sregex_iterator();
+    KeywordStream() = default;
+    KeywordStream(shared_ptr<const KeywordAutomaton> ac, StreamAbortMode mode)
+        : automaton(move(ac)), abort_mode(mode) {
+        found.assign(automaton->pattern_count(), false);
+    }
     
-    for (sregex_iterator i = words_begin; i != words_end; ++i) {
-        smatch match = *i;
-        urls.push_back(match.str());
+    bool should_abort() const {
+        if (abort_mode == StreamAbortMode::FIRST_HIT) return found_count > 0;
+        if (abort_mode == StreamAbortMode::ALL_FOUND) return found_count == found.size() && !found.empty();
+        return false;
     }
     
-    return urls;
-}
+    // Retourne false quand le transfert doit être interrompu
+    bool feed(const char* data, size_t len) {
+        bytes += len;
+        hasher.update(data, len);
+        if (found_count < found.size()) {
+            state = automaton->scan(state, data, len, [this](uint32_t id) {
+                if (!found[id]) {
+                    found[id] = true;
+                    found_count++;
+                }
+                return found_count < found.size();
+            });
+        }
+        if (should_abort()) {
+            aborted = true;
+            return false;
+        }
+        return true;
+    }
+    
+    // Mots-clés trouvés, dans l'ordre du jeu de mots-clés
+    vector<string> found_keywords() const {
+        vector<string> result;
+        for (size_t id = 0; id < found.size(); id++) {
+            if (found[id]) result.push_back(automaton->pattern(id));
+        }
+        return result;
+    }
+};
+
+// Résultat d'un scan de corps de réponse (streaming ou corps complet)
+struct SourceScan {
+    uint64_t keyword_signature = 0;
+    size_t bytes = 0;
+    uint64_t content_hash = 0; // 0 si transfert interrompu
+    bool truncated = false;
+    vector<string> found_keywords;
+};
+
+SourceScan scan_result(const KeywordStream& stream) {
+    SourceScan scan;
+    scan.keyword_signature = stream.automaton->keyword_signature();
+    scan.bytes = stream.bytes;
+    scan.truncated = stream.aborted;
+    scan.content_hash = stream.aborted ? 0 : stream.hasher.digest();
+    scan.found_keywords = stream.found_keywords();
+    return scan;
+}
+
+// Callback libcurl en streaming: les mots-clés sont cherchés à l'arrivée de chaque chunk
+size_t StreamingWriteCallback(void* contents, size_t size, size_t nmemb, KeywordStream* stream) {
+    size_t len = size * nmemb;
+    return stream->feed((const char*)contents, len) ? len : 0;
+}
+
+// Recherche multi-mots-clés insensible à la casse, vectorisée, en un seul passage
+// Filtre premier/dernier octet par bloc (OR 0x20 replie la casse ASCII, sur-ensemble
+// des correspondances), vérification exacte des candidats. Aucune copie en minuscules.
+struct ScanNeedle {
+    const char* folded;  // motif en minuscules
+    size_t len;
+    uint8_t first;       // premier / dernier octet | 0x20
+    uint8_t last;
+};
+
+const uint8_t* ascii_fold_table() {
+    static const auto table = []() {
+        array<uint8_t, 256> t{};
+        for (int c = 0; c < 256; c++) t[c] = (uint8_t)((c >= 'A' && c <= 'Z') ? c + 32 : c);
+        return t;
+    }();
+    return table.data();
+}
+
+inline bool ci_match(const char* text, const ScanNeedle& needle) {
+    const uint8_t* fold = ascii_fold_table();
+    for (size_t j = 0; j < needle.len; j++) {
+        if (fold[(uint8_t)text[j]] != (uint8_t)needle.folded[j]) return false;
+    }
+    return true;
+}
+
+// found[k] = 1 si needles[k] apparaît dans text
+using ScanKernel = void (*)(const ScanNeedle* needles, size_t count, const char* text, size_t len, uint8_t* found);
+
+// Positions [from, len - needle.len] vérifiées octet par octet
+inline void scan_needle_scalar(const ScanNeedle& needle, const char* text, size_t len, size_t from, uint8_t& found) {
+    if (found || needle.len == 0 || needle.len > len) return;
+    for (size_t i = from; i + needle.len <= len; i++) {
+        if (((uint8_t)text[i] | 0x20) == needle.first &&
+            ((uint8_t)text[i + needle.len - 1] | 0x20) == needle.last &&
+            ci_match(text + i, needle)) {
+            found = 1;
+            return;
+        }
+    }
+}
+
+void scan_kernel_scalar(const ScanNeedle* needles, size_t count, const char* text, size_t len, uint8_t* found) {
+    for (size_t k = 0; k < count; k++) scan_needle_scalar(needles[k], text, len, 0, found[k]);
+}
+
+// Fin de la zone couverte par les blocs vectoriels de largeur W pour un motif donné
+inline size_t simd_covered_end(size_t len, size_t needle_len, size_t width) {
+    if (needle_len == 0 || len < needle_len + width - 1) return 0;
+    return ((len - needle_len - (width - 1)) / width + 1) * width;
+}
+
+// Boucle commune aux noyaux SIMD. Macro plutôt que template: le corps doit être compilé
+// dans le contexte target("avx2") du noyau appelant. Attend LOAD_FOLDED(p) et
+// MATCH_MASK(block_first, block_last, first, last) définis par le noyau.
+#define PM_SCAN_BLOCKS(W, BITS_PER_BYTE)                                                              \
+    do {                                                                                              \
+        size_t remaining = 0;                                                                         \
+        for (size_t k = 0; k < count; k++) {                                                          \
+            if (!found[k] && needles[k].len > 0 && needles[k].len <= len) remaining++;                \
+        }                                                                                             \
+        for (size_t i = 0; remaining > 0 && i + (W) <= len; i += (W)) {                               \
+            auto block_first = LOAD_FOLDED(text + i);                                                 \
+            for (size_t k = 0; k < count; k++) {                                                      \
+                const ScanNeedle& needle = needles[k];                                                \
+                if (found[k] || needle.len == 0 || i + needle.len - 1 + (W) > len) continue;          \
+                auto block_last = LOAD_FOLDED(text + i + needle.len - 1);                             \
+                uint64_t mask = MATCH_MASK(block_first, block_last, needle.first, needle.last);       \
+                while (mask) {                                                                        \
+                    size_t bit = __builtin_ctzll(mask) / (BITS_PER_BYTE);                             \
+                    if (ci_match(text + i + bit, needle)) {                                           \
+                        found[k] = 1;                                                                 \
+                        remaining--;                                                                  \
+                        break;                                                                        \
+                    }                                                                                 \
+                    mask &= ~(((uint64_t(1) << (BITS_PER_BYTE)) - 1) << (bit * (BITS_PER_BYTE)));     \
+                }                                                                                     \
+            }                                                                                         \
+        }                                                                                             \
+        for (size_t k = 0; k < count; k++) {                                                          \
+            scan_needle_scalar(needles[k], text, len, simd_covered_end(len, needles[k].len, (W)), found[k]); \
+        }                                                                                             \
+    } while (0)
+
+#if defined(__x86_64__)
+void scan_kernel_sse2(const ScanNeedle* needles, size_t count, const char* text, size_t len, uint8_t* found) {
+#define LOAD_FOLDED(p) _mm_or_si128(_mm_loadu_si128((const __m128i*)(p)), _mm_set1_epi8(0x20))
+#define MATCH_MASK(a, b, f, l) (uint32_t)_mm_movemask_epi8(_mm_and_si128( \
+        _mm_cmpeq_epi8(a, _mm_set1_epi8((char)(f))), _mm_cmpeq_epi8(b, _mm_set1_epi8((char)(l)))))
+    PM_SCAN_BLOCKS(16, 1);
+#undef LOAD_FOLDED
+#undef MATCH_MASK
+}
+
+__attribute__((target("avx2")))
+void scan_kernel_avx2(const ScanNeedle* needles, size_t count, const char* text, size_t len, uint8_t* found) {
+#define LOAD_FOLDED(p) _mm256_or_si256(_mm256_loadu_si256((const __m256i*)(p)), _mm256_set1_epi8(0x20))
+#define MATCH_MASK(a, b, f, l) (uint32_t)_mm256_movemask_epi8(_mm256_and_si256( \
+        _mm256_cmpeq_epi8(a, _mm256_set1_epi8((char)(f))), _mm256_cmpeq_epi8(b, _mm256_set1_epi8((char)(l)))))
+    PM_SCAN_BLOCKS(32, 1);
+#undef LOAD_FOLDED
+#undef MATCH_MASK
+}
+#endif
+
+#if defined(__aarch64__)
+// Pas de movemask sur NEON: vshrn produit un masque de 4 bits par octet
+void scan_kernel_neon(const ScanNeedle* needles, size_t count, const char* text, size_t len, uint8_t* found) {
+#define LOAD_FOLDED(p) vorrq_u8(vld1q_u8((const uint8_t*)(p)), vdupq_n_u8(0x20))
+#define MATCH_MASK(a, b, f, l) vget_lane_u64(vreinterpret_u64_u8(vshrn_n_u16(vreinterpretq_u16_u8( \
+        vandq_u8(vceqq_u8(a, vdupq_n_u8(f)), vceqq_u8(b, vdupq_n_u8(l)))), 4)), 0)
+    PM_SCAN_BLOCKS(16, 4);
+#undef LOAD_FOLDED
+#undef MATCH_MASK
+}
+#endif
+
+// Sélection du noyau à l'exécution selon le CPU
+struct ScanKernelInfo {
+    ScanKernel kernel;
+    const char* name;
+};
+
+bool cpu_supports_avx2() {
+#if defined(__x86_64__)
+    __builtin_cpu_init();
+    return __builtin_cpu_supports("avx2");
+#else
+    return false;
+#endif
+}
+
+ScanKernelInfo select_scan_kernel() {
+#if defined(__x86_64__)
+    if (cpu_supports_avx2()) return {scan_kernel_avx2, "avx2"};
+    return {scan_kernel_sse2, "sse2"};
+#elif defined(__aarch64__)
+    return {scan_kernel_neon, "neon"};
+#else
+    return {scan_kernel_scalar, "scalar"};
+#endif
+}
+
+const ScanKernelInfo& active_scan_kernel() {
+    static const ScanKernelInfo info = select_scan_kernel();
+    return info;
+}
+
+// Jeu de mots-clés préparé pour le noyau SIMD
+class CaseInsensitiveScanner {
+private:
+    vector<string> keywords;
+    vector<string> folded;
+    vector<ScanNeedle> needles;
+    uint64_t signature;
+    
+public:
+    explicit CaseInsensitiveScanner(const vector<string>& kws)
+        : keywords(kws), signature(keyword_set_signature(kws)) {
+        const uint8_t* fold = ascii_fold_table();
+        for (const auto& keyword : keywords) {
+            string f = keyword;
+            for (auto& c : f) c = (char)fold[(uint8_t)c];
+            folded.push_back(move(f));
+        }
+        for (const auto& f : folded) {
+            ScanNeedle needle{f.data(), f.size(), 0, 0};
+            if (!f.empty()) {
+                needle.first = (uint8_t)f.front() | 0x20;
+                needle.last = (uint8_t)f.back() | 0x20;
+            }
+            needles.push_back(needle);
+        }
+    }
+    
+    CaseInsensitiveScanner(const CaseInsensitiveScanner&) = delete;
+    CaseInsensitiveScanner& operator=(const CaseInsensitiveScanner&) = delete;
+    
+    size_t size() const { return keywords.size(); }
+    const string& keyword(size_t id) const { return keywords[id]; }
+    uint64_t keyword_signature() const { return signature; }
+    
+    // found[k] = 1 si keywords[k] apparaît dans text
+    vector<uint8_t> scan(const char* text, size_t len, ScanKernel kernel = nullptr) const {
+        vector<uint8_t> found(needles.size(), 0);
+        if (!kernel) kernel = active_scan_kernel().kernel;
+        kernel(needles.data(), needles.size(), text, len, found.data());
+        return found;
+    }
+    
+    // Mots-clés trouvés, dans l'ordre du jeu de mots-clés
+    vector<string> found_keywords(const char* text, size_t len) const {
+        vector<uint8_t> found = scan(text, len);
+        vector<string> result;
+        for (size_t k = 0; k < found.size(); k++) {
+            if (found[k]) result.push_back(keywords[k]);
+        }
+        return result;
+    }
+};
+
+shared_ptr<const CaseInsensitiveScanner> ci_scanner_for(const vector<string>& keywords) {
+    static mutex cache_mutex;
+    static map<uint64_t, shared_ptr<const CaseInsensitiveScanner>> cache;
+    
+    uint64_t signature = keyword_set_signature(keywords);
+    lock_guard<mutex> lock(cache_mutex);
+    auto it = cache.find(signature);
+    if (it != cache.end()) return it->second;
+    
+    if (cache.size() >= 64) cache.clear();
+    auto scanner = make_shared<const CaseInsensitiveScanner>(keywords);
+    cache[signature] = scanner;
+    return scanner;
+}
+
+// Options communes aux handles persistants: cache partagé, keep-alive, HTTP/2
+void apply_persistent_connection_opts(CURL* easy, CURLSH* share) {
+    if (share) curl_easy_setopt(easy, CURLOPT_SHARE, share);
+    curl_easy_setopt(easy, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_2TLS);
+    curl_easy_setopt(easy, CURLOPT_PIPEWAIT, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPALIVE, 1L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPIDLE, 60L);
+    curl_easy_setopt(easy, CURLOPT_TCP_KEEPINTVL, 30L);
+    curl_easy_setopt(easy, CURLOPT_DNS_CACHE_TIMEOUT, 300L);
+    curl_easy_setopt(easy, CURLOPT_TCP_NODELAY, 1L);
+    curl_easy_setopt(easy, CURLOPT_NOSIGNAL, 1L);
+}
+
+// ===== MODÈLE DE LATENCE MESURÉ =====
+// Chaque requête enregistre ses temps curl (DNS, connexion, TLS, premier octet, total) par hôte:
+// moyennes exponentielles pour la tendance, histogramme log-linéaire (façon HDR) pour les quantiles.
+// Enregistrement sans verrou (atomiques relaxés); seul l'ajout d'un nouvel hôte prend un mutex.
+constexpr double LATENCY_EWMA_ALPHA = 0.2;
+constexpr uint64_t LATENCY_MIN_SAMPLES = 3; // en dessous, quantiles non significatifs
+
+// Histogramme log-linéaire d'entiers: valeurs < 32 exactes, puis 32 sous-intervalles par
+// puissance de 2 (erreur relative < 3%), jusqu'à 2^40. Latences réseau en microsecondes
+// (record/quantile en secondes), étapes du pipeline en nanosecondes (record_value).
+class LatencyHistogram {
+private:
+    static constexpr int SUB_BITS = 5;
+    static constexpr uint64_t SUB_COUNT = 1ull << SUB_BITS;
+    static constexpr int MAX_EXPONENT = 40;
+    static constexpr size_t BUCKETS = SUB_COUNT + (MAX_EXPONENT - SUB_BITS + 1) * SUB_COUNT;
+    
+    std::array<atomic<uint64_t>, BUCKETS> counts{};
+    atomic<uint64_t> total{0};
+    atomic<uint64_t> largest{0};
+    
+    static size_t bucket_of(uint64_t value) {
+        if (value < SUB_COUNT) return (size_t)value;
+        int exponent = min(63 - __builtin_clzll(value), MAX_EXPONENT);
+        uint64_t mantissa = exponent == MAX_EXPONENT ? SUB_COUNT - 1 : (value >> (exponent - SUB_BITS)) & (SUB_COUNT - 1);
+        return SUB_COUNT + (size_t)(exponent - SUB_BITS) * SUB_COUNT + mantissa;
+    }
+    
+    // Milieu de l'intervalle du bucket
+    static double bucket_value(size_t bucket) {
+        if (bucket < SUB_COUNT) return (double)bucket;
+        int exponent = (int)((bucket - SUB_COUNT) / SUB_COUNT) + SUB_BITS;
+        uint64_t mantissa = (bucket - SUB_COUNT) % SUB_COUNT;
+        double width = (double)(1ull << (exponent - SUB_BITS));
+        return (double)((SUB_COUNT + mantissa) << (exponent - SUB_BITS)) + width / 2.0;
+    }
+    
+public:
+    void record_value(uint64_t value) {
+        counts[bucket_of(value)].fetch_add(1, memory_order_relaxed);
+        total.fetch_add(1, memory_order_relaxed);
+        uint64_t seen = largest.load(memory_order_relaxed);
+        while (value > seen && !largest.compare_exchange_weak(seen, value, memory_order_relaxed)) {}
+    }
+    
+    void record(double seconds) {
+        record_value(seconds <= 0.0 ? 0 : (uint64_t)min(seconds * 1e6, 1e12));
+    }
+    
+    uint64_t count() const { return total.load(memory_order_relaxed); }
+    
+    // Plus grande valeur enregistrée (exacte, même unité que record_value)
+    uint64_t max_value() const { return largest.load(memory_order_relaxed); }
+    
+    // Quantile q dans [0, 1], même unité que record_value; NaN si vide
+    double quantile_value(double q) const {
+        uint64_t n = count();
+        if (n == 0) return NAN;
+        uint64_t rank = (uint64_t)ceil(min(max(q, 0.0), 1.0) * n);
+        if (rank == 0) rank = 1;
+        uint64_t seen = 0;
+        for (size_t b = 0; b < BUCKETS; b++) {
+            seen += counts[b].load(memory_order_relaxed);
+            if (seen >= rank) return bucket_value(b);
+        }
+        return bucket_value(BUCKETS - 1);
+    }
+    
+    // Quantile q en secondes (valeurs enregistrées par record)
+    double quantile(double q) const {
+        return quantile_value(q) / 1e6;
+    }
+};
+
+// Moyenne exponentielle atomique (CAS), NaN tant qu'aucun échantillon
+class AtomicEwma {
+private:
+    atomic<double> value{NAN};
+    
+public:
+    void update(double sample) {
+        double current = value.load(memory_order_relaxed);
+        double next;
+        do {
+            next = std::isnan(current) ? sample : current + LATENCY_EWMA_ALPHA * (sample - current);
+        } while (!value.compare_exchange_weak(current, next, memory_order_relaxed));
+    }
+    
+    double get() const { return value.load(memory_order_relaxed); }
+};
+
+// Temps d'une requête, en secondes, par phase (0 si la connexion a été réutilisée)
+struct RequestTiming {
+    double dns;
+    double connect;
+    double tls;
+    double ttfb;
+    double total;
+};
+
+struct HostLatency {
+    AtomicEwma dns, connect, tls, ttfb, total;
+    LatencyHistogram ttfb_histogram, total_histogram;
+    atomic<uint64_t> failures{0};
+    
+    void record(const RequestTiming& t, bool complete) {
+        dns.update(t.dns);
+        connect.update(t.connect);
+        tls.update(t.tls);
+        ttfb.update(t.ttfb);
+        ttfb_histogram.record(t.ttfb);
+        if (complete) { // transfert interrompu volontairement: le total n'est pas représentatif
+            total.update(t.total);
+            total_histogram.record(t.total);
+        }
+    }
+};
+
+// Hôte d'une URL ou d'un nom d'hôte: "https://www.sec.gov:443/x" -> "www.sec.gov"
+string latency_host_key(string_view endpoint) {
+    size_t scheme = endpoint.find("://");
+    if (scheme != string_view::npos) endpoint.remove_prefix(scheme + 3);
+    size_t end = endpoint.find_first_of(":/?#");
+    if (end != string_view::npos) endpoint = endpoint.substr(0, end);
+    string host(endpoint);
+    for (char& c : host) c = (char)tolower((unsigned char)c);
+    return host;
+}
+
+class LatencyModel {
+private:
+    mutable mutex hosts_mutex;
+    unordered_map<string, unique_ptr<HostLatency>> hosts; // jamais retirés: pointeurs stables
+    HostLatency all_hosts;
+    
+public:
+    HostLatency* host(const string& key, bool create) {
+        lock_guard<mutex> lock(hosts_mutex);
+        auto it = hosts.find(key);
+        if (it != hosts.end()) return it->second.get();
+        if (!create) return nullptr;
+        return hosts.emplace(key, make_unique<HostLatency>()).first->second.get();
+    }
+    
+    HostLatency& overall() { return all_hosts; }
+    
+    void record(const string& url, const RequestTiming& timing, bool complete) {
+        host(latency_host_key(url), true)->record(timing, complete);
+        all_hosts.record(timing, complete);
+    }
+    
+    void record_failure(const string& url) {
+        host(latency_host_key(url), true)->failures.fetch_add(1, memory_order_relaxed);
+        all_hosts.failures.fetch_add(1, memory_order_relaxed);
+    }
+};
+
+LatencyModel latency_model;
+
+// Latence prévue d'un hôte (secondes): médiane mesurée, sinon moyenne exponentielle,
+// sinon valeur a priori (hôtes connus) ou 50ms
+double predicted_latency(const string& host_key) {
+    static const unordered_map<string, double> prior_latency = {
+        {"gamma-api.polymarket.com", 0.035},
+        {"clob.polymarket.com", 0.040},
+        {"api.stlouisfed.org", 0.050},
+        {"www.federalreserve.gov", 0.045},
+        {"www.sec.gov", 0.055},
+        {"www.coindesk.com", 0.060}
+    };
+    
+    if (const HostLatency* host = latency_model.host(host_key, false)) {
+        if (host->total_histogram.count() >= LATENCY_MIN_SAMPLES) return host->total_histogram.quantile(0.5);
+        double ewma = host->total.get();
+        if (!std::isnan(ewma)) return ewma;
+    }
+    auto it = prior_latency.find(host_key);
+    return it != prior_latency.end() ? it->second : 0.050;
+}
+
+// Relevé des temps d'un transfert curl terminé (CURLINFO_*_TIME_T, en µs)
+void record_transfer_latency(CURL* easy, CURLcode result, bool complete = true) {
+    char* url = nullptr;
+    curl_easy_getinfo(easy, CURLINFO_EFFECTIVE_URL, &url);
+    if (!url) return;
+    if (result != CURLE_OK && complete) {
+        latency_model.record_failure(url);
+        return;
+    }
+    
+    curl_off_t dns = 0, connect = 0, tls = 0, ttfb = 0, total = 0;
+    curl_easy_getinfo(easy, CURLINFO_NAMELOOKUP_TIME_T, &dns);
+    curl_easy_getinfo(easy, CURLINFO_CONNECT_TIME_T, &connect);
+    curl_easy_getinfo(easy, CURLINFO_APPCONNECT_TIME_T, &tls);
+    curl_easy_getinfo(easy, CURLINFO_STARTTRANSFER_TIME_T, &ttfb);
+    curl_easy_getinfo(easy, CURLINFO_TOTAL_TIME_T, &total);
+    
+    // Temps cumulés depuis le début -> durée de chaque phase
+    RequestTiming timing;
+    timing.dns = dns / 1e6;
+    timing.connect = connect > dns ? (connect - dns) / 1e6 : 0.0;
+    timing.tls = tls > connect ? (tls - connect) / 1e6 : 0.0;
+    timing.ttfb = ttfb / 1e6;
+    timing.total = total / 1e6;
+    latency_model.record(url, timing, complete);
+}
+
+// ===== INSTRUMENTATION DU CHEMIN CRITIQUE =====
+// Horodatages steady_clock en ns (vDSO, lit le TSC sur x86 sans calibration à faire).
+// Un cycle (REST ou lot du flux temps réel) cumule son temps par étape dans un StageTimes,
+// versé en fin de cycle dans un histogramme par étape. Chaque signal porte l'instant où la
+// donnée qui l'a produit a été observée: réaction (observation -> décision) et bout en bout
+// (observation -> publication) sont mesurés par signal.
+enum class PipelineStage : uint8_t { FETCH, PARSE, MATCH, DETECT, PRICE, DECIDE, EMIT };
+constexpr size_t PIPELINE_STAGE_COUNT = 7;
+
+inline uint64_t pipeline_clock_ns() {
+    return (uint64_t)chrono::duration_cast<chrono::nanoseconds>(chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+struct StageTimes {
+    std::array<uint64_t, PIPELINE_STAGE_COUNT> ns{};
+    uint8_t ran = 0; // étapes exécutées ce cycle (bit par étape)
+    
+    void add(PipelineStage stage, uint64_t elapsed_ns) {
+        ns[(size_t)stage] += elapsed_ns;
+        ran |= (uint8_t)(1u << (size_t)stage);
+    }
+    
+    // Temps écoulé depuis start_ns attribué à l'étape; renvoie l'instant courant (début de la suivante)
+    uint64_t lap(PipelineStage stage, uint64_t start_ns) {
+        uint64_t now = pipeline_clock_ns();
+        add(stage, now - start_ns);
+        return now;
+    }
+};
+
+class PipelineStats {
+private:
+    std::array<LatencyHistogram, PIPELINE_STAGE_COUNT> stages;
+    
+public:
+    LatencyHistogram reaction;   // ns, par signal émis
+    LatencyHistogram end_to_end; // ns, par delta publié
+    
+    void record(const StageTimes& times) {
+        for (size_t i = 0; i < PIPELINE_STAGE_COUNT; i++) {
+            if (times.ran & (1u << i)) stages[i].record_value(times.ns[i]);
+        }
+    }
+    
+    const LatencyHistogram& stage(PipelineStage stage) const { return stages[(size_t)stage]; }
+};
+
+PipelineStats pipeline_stats;
+
+// Classe HTTP Client optimisée
+// curl_global_init doit avoir été appelé (voir HTTPConnectionPool)
+class FastHTTPClient {
+private:
+    CURL* curl;
+    struct curl_slist* headers;
+    
+public:
+    explicit FastHTTPClient(CURLSH* share = nullptr) {
+        curl = curl_easy_init();
+        headers = nullptr;
+        
+        if (curl) {
+            headers = curl_slist_append(headers, "User-Agent: Polymarket-Bot/1.0");
+            headers = curl_slist_append(headers, "Accept: application/json");
+            headers = curl_slist_append(headers, "Content-Type: application/json");
+            curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+            curl_easy_setopt(curl, CURLOPT_TIMEOUT, REQUEST_TIMEOUT_MS / 1000);
+            curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT, 3);
+            curl_easy_setopt(curl, CURLOPT_TCP_FASTOPEN, 1L);
+            apply_persistent_connection_opts(curl, share);
+        }
+    }
+    
+    ~FastHTTPClient() {
+        if (headers) curl_slist_free_all(headers);
+        if (curl) curl_easy_cleanup(curl);
+    }
+    
+    FastHTTPClient(const FastHTTPClient&) = delete;
+    FastHTTPClient& operator=(const FastHTTPClient&) = delete;
+    
+    string GET(const string& url) {
+        string response;
+        
+        if (!curl) return "";
+        
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L); // handle réutilisé après un éventuel POST
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        
+        CURLcode res = curl_easy_perform(curl);
+        record_transfer_latency(curl, res);
+        
+        if (res != CURLE_OK) {
+            return "";
+        }
+        
+        return response;
+    }
+    
+    // GET conditionnel: 304 si le contenu n'a pas changé depuis etag / last_modified
+    HTTPResponse GET_conditional(const string& url, const string& etag, const string& last_modified) {
+        HTTPResponse response;
+        
+        if (!curl) return response;
+        
+        struct curl_slist* request_headers = nullptr;
+        for (struct curl_slist* h = headers; h; h = h->next) {
+            request_headers = curl_slist_append(request_headers, h->data);
+        }
+        request_headers = append_conditional_headers(request_headers, etag, last_modified);
+        
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_HTTPGET, 1L);
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, request_headers);
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response.body);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, &response);
+        
+        CURLcode res = curl_easy_perform(curl);
+        record_transfer_latency(curl, res);
+        if (res == CURLE_OK) {
+            curl_easy_getinfo(curl, CURLINFO_RESPONSE_CODE, &response.status);
+        } else {
+            response.body.clear();
+        }
+        
+        // Retour à l'état par défaut pour les appels GET/POST suivants
+        curl_easy_setopt(curl, CURLOPT_HTTPHEADER, headers);
+        curl_easy_setopt(curl, CURLOPT_HEADERFUNCTION, nullptr);
+        curl_easy_setopt(curl, CURLOPT_HEADERDATA, nullptr);
+        curl_slist_free_all(request_headers);
+        
+        return response;
+    }
+    
+    string POST(const string& url, const string& data) {
+        string response;
+        
+        if (!curl) return "";
+        
+        curl_easy_setopt(curl, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(curl, CURLOPT_POST, 1L);
+        curl_easy_setopt(curl, CURLOPT_POSTFIELDS, data.c_str());
+        curl_easy_setopt(curl, CURLOPT_WRITEFUNCTION, WriteCallback);
+        curl_easy_setopt(curl, CURLOPT_WRITEDATA, &response);
+        
+        CURLcode res = curl_easy_perform(curl);
+        record_transfer_latency(curl, res);
+        
+        if (res != CURLE_OK) {
+            return "";
+        }
+        
+        return response;
+    }
+};
+
+// Fonctions utilitaires
+string get_current_timestamp() {
+    auto now = chrono::system_clock::now();
+    auto time_t = chrono::system_clock::to_time_t(now);
+    auto ms = chrono::duration_cast<chrono::milliseconds>(now.time_since_epoch()) % 1000;
+    
+    stringstream ss;
+    ss << put_time(localtime(&time_t), "%Y-%m-%d %H:%M:%S");
+    ss << '.' << setfill('0') << setw(3) << ms.count();
+    return ss.str();
+}
+
+// Extraction d'URL sans std::regex, même sémantique que https?://[^\s]+ (sensible à la casse).
+// Les vues pointent dans le texte d'origine: aucune allocation par URL.
+static inline bool url_space(char c) {
+    return c == ' ' || (c >= '\t' && c <= '\r');
+}
+
+template <typename F>
+void scan_urls(string_view text, F&& on_url) {
+    const char* p = text.data();
+    const char* end = p + text.size();
+    while (end - p >= 8) {
+        p = (const char*)memchr(p, 'h', end - p - 7);
+        if (!p) return;
+        if (memcmp(p, "http", 4) != 0) {
+            p++;
+            continue;
+        }
+        const char* q = p + 4;
+        if (*q == 's') q++;
+        if (end - q < 4 || memcmp(q, "://", 3) != 0 || url_space(q[3])) {
+            p++;
+            continue;
+        }
+        q += 3;
+        while (q < end && !url_space(*q)) q++;
+        on_url(string_view(p, q - p));
+        p = q;
+    }
+}
+
+vector<string_view> extract_url_views(string_view text) {
+    vector<string_view> urls;
+    scan_urls(text, [&](string_view url) { urls.push_back(url); });
+    return urls;
+}
+
+vector<string> extract_urls(const string& text) {
+    vector<string> urls;
+    scan_urls(text, [&](string_view url) { urls.emplace_back(url); });
+    return urls;
+}
 
 string extract_resolution_source(const string& description) {
     if (description.find("resolution source") != string::npos) {
@@ -273,278 +1725,4504 @@ string extract_resolution_source(const string& description) {
             return description.substr(pos);
         }
     }
-    return "";
-}
-
-vector<string> extract_market_keywords(const string& question, const string& description) {
-    vector<string> keywords;
-    string text = question + " " + description;
-    transform(text.begin(), text.end(), text.begin(), ::tolower);
+    return "";
+}
+
+// ===== PARSEUR JSON À LA DEMANDE =====
+// Lecture séquentielle sans arbre ni DOM: le code appelant parcourt les champs dans l'ordre
+// du document, décode seulement ceux qu'il garde et saute les autres valeurs (chaînes et
+// conteneurs imbriqués) par recherche de délimiteurs, sans allocation.
+class JsonCursor {
+private:
+    const char* p;
+    const char* end;
+    bool failed = false;
+    
+    bool fail() {
+        failed = true;
+        p = end;
+        return false;
+    }
+    
+    void skip_ws() {
+        while (p < end && (*p == ' ' || *p == '\n' || *p == '\r' || *p == '\t')) p++;
+    }
+    
+    // p sur le guillemet ouvrant; renvoie la fin du contenu (guillemet fermant)
+    const char* find_string_end(bool& has_escape) {
+        const char* q = p + 1;
+        while (true) {
+            q = (const char*)memchr(q, '"', end - q);
+            if (!q) return nullptr;
+            const char* b = q;
+            while (b > p + 1 && b[-1] == '\\') b--;
+            if (((q - b) & 1) == 0) break;
+            q++;
+        }
+        has_escape = memchr(p + 1, '\\', q - p - 1) != nullptr;
+        return q;
+    }
+    
+    static void append_utf8(string& out, uint32_t cp) {
+        if (cp < 0x80) {
+            out += (char)cp;
+        } else if (cp < 0x800) {
+            out += (char)(0xC0 | (cp >> 6));
+            out += (char)(0x80 | (cp & 0x3F));
+        } else if (cp < 0x10000) {
+            out += (char)(0xE0 | (cp >> 12));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        } else {
+            out += (char)(0xF0 | (cp >> 18));
+            out += (char)(0x80 | ((cp >> 12) & 0x3F));
+            out += (char)(0x80 | ((cp >> 6) & 0x3F));
+            out += (char)(0x80 | (cp & 0x3F));
+        }
+    }
+    
+    static bool read_hex4(const char* s, const char* limit, uint32_t& out) {
+        if (limit - s < 4) return false;
+        out = 0;
+        for (int i = 0; i < 4; i++) {
+            char c = s[i];
+            out <<= 4;
+            if (c >= '0' && c <= '9') out |= c - '0';
+            else if (c >= 'a' && c <= 'f') out |= c - 'a' + 10;
+            else if (c >= 'A' && c <= 'F') out |= c - 'A' + 10;
+            else return false;
+        }
+        return true;
+    }
+    
+    static void decode_escapes(const char* s, const char* limit, string& out) {
+        out.clear();
+        out.reserve(limit - s);
+        while (s < limit) {
+            const char* bs = (const char*)memchr(s, '\\', limit - s);
+            if (!bs) bs = limit;
+            out.append(s, bs - s);
+            if (bs >= limit - 1) break;
+            s = bs + 2;
+            switch (bs[1]) {
+                case 'n': out += '\n'; break;
+                case 't': out += '\t'; break;
+                case 'r': out += '\r'; break;
+                case 'b': out += '\b'; break;
+                case 'f': out += '\f'; break;
+                case 'u': {
+                    uint32_t cp;
+                    if (!read_hex4(s, limit, cp)) break;
+                    s += 4;
+                    uint32_t low;
+                    if (cp >= 0xD800 && cp < 0xDC00 && limit - s >= 6 && s[0] == '\\' && s[1] == 'u' &&
+                        read_hex4(s + 2, limit, low) && low >= 0xDC00 && low < 0xE000) {
+                        cp = 0x10000 + ((cp - 0xD800) << 10) + (low - 0xDC00);
+                        s += 6;
+                    }
+                    append_utf8(out, cp);
+                    break;
+                }
+                default: out += bs[1]; break; // \" \\ \/
+            }
+        }
+    }
+    
+public:
+    explicit JsonCursor(string_view text) : p(text.data()), end(text.data() + text.size()) {}
+    
+    bool ok() const { return !failed; }
+    
+    // Premier caractère significatif de la valeur suivante (0 en fin de texte)
+    char peek() {
+        skip_ws();
+        return p < end ? *p : 0;
+    }
+    
+    bool begin_object() {
+        skip_ws();
+        if (p < end && *p == '{') { p++; return true; }
+        return fail();
+    }
+    
+    bool begin_array() {
+        skip_ws();
+        if (p < end && *p == '[') { p++; return true; }
+        return fail();
+    }
+    
+    // Champ suivant de l'objet courant (false à la fermeture); la valeur doit ensuite être
+    // lue ou sautée. Les clés sont rendues brutes (sans décodage des échappements).
+    bool next_field(string_view& key) {
+        skip_ws();
+        if (p >= end) return fail();
+        if (*p == '}') { p++; return false; }
+        if (*p == ',') { p++; skip_ws(); }
+        if (p >= end || *p != '"') return fail();
+        bool has_escape;
+        const char* close = find_string_end(has_escape);
+        if (!close) return fail();
+        key = string_view(p + 1, close - p - 1);
+        p = close + 1;
+        skip_ws();
+        if (p >= end || *p != ':') return fail();
+        p++;
+        return true;
+    }
+    
+    // Élément suivant du tableau courant (false à la fermeture)
+    bool next_element() {
+        skip_ws();
+        if (p >= end) return fail();
+        if (*p == ']') { p++; return false; }
+        if (*p == ',') p++;
+        return true;
+    }
+    
+    // null (fréquent dans le CLOB: "description": null, "end_date_iso": null) est lu comme ""
+    bool read_string(string& out) {
+        skip_ws();
+        if (end - p >= 4 && memcmp(p, "null", 4) == 0) {
+            out.clear();
+            p += 4;
+            return true;
+        }
+        if (p >= end || *p != '"') return fail();
+        bool has_escape;
+        const char* close = find_string_end(has_escape);
+        if (!close) return fail();
+        if (has_escape) decode_escapes(p + 1, close, out);
+        else out.assign(p + 1, close - p - 1);
+        p = close + 1;
+        return true;
+    }
+    
+    // Nombre, ou chaîne contenant un nombre (prix du CLOB: "0.55")
+    bool read_number(double& out) {
+        skip_ws();
+        if (p >= end) return fail();
+        bool quoted = *p == '"';
+        const char* start = quoted ? p + 1 : p;
+        auto result = std::from_chars(start, end, out);
+        if (result.ec != std::errc()) {
+            skip_value();
+            return false;
+        }
+        p = result.ptr;
+        if (quoted) {
+            if (p >= end || *p != '"') return fail();
+            p++;
+        }
+        return true;
+    }
+    
+    bool read_bool(bool& out) {
+        skip_ws();
+        if (end - p >= 4 && memcmp(p, "true", 4) == 0) { out = true; p += 4; return true; }
+        if (end - p >= 5 && memcmp(p, "false", 5) == 0) { out = false; p += 5; return true; }
+        skip_value();
+        return false;
+    }
+    
+    void skip_value() {
+        skip_ws();
+        if (p >= end) { fail(); return; }
+        char c = *p;
+        if (c == '"') {
+            bool has_escape;
+            const char* close = find_string_end(has_escape);
+            if (!close) { fail(); return; }
+            p = close + 1;
+            return;
+        }
+        if (c == '{' || c == '[') {
+            int depth = 0;
+            while (p < end) {
+                char d = *p;
+                if (d == '"') {
+                    bool has_escape;
+                    const char* close = find_string_end(has_escape);
+                    if (!close) { fail(); return; }
+                    p = close + 1;
+                    continue;
+                }
+                if (d == '{' || d == '[') depth++;
+                else if (d == '}' || d == ']') {
+                    if (--depth == 0) { p++; return; }
+                }
+                p++;
+            }
+            fail();
+            return;
+        }
+        // Scalaire: nombre, true, false, null
+        while (p < end && *p != ',' && *p != '}' && *p != ']' && *p != ' ' && *p != '\n' && *p != '\r' && *p != '\t') p++;
+    }
+};
+
+// ===== TAXONOMIE DES MARCHÉS =====
+// Domaines (par ordre de priorité) et mots-clés de marché décrits par une configuration JSON,
+// compilés en un seul automate: un passage sur le texte d'un marché donne son domaine et ses
+// mots-clés. Le résultat est calculé à l'ingestion et gardé dans le Market.
+//   {"default_domain": "other",
+//    "domains":  [{"name": "economy", "terms": ["fed", "rate"]}, ...],
+//    "keywords": [{"keyword": "federal reserve", "triggers": ["fed"]}, ...]}
+const char* BUILTIN_MARKET_TAXONOMY = R"({
+  "default_domain": "other",
+  "domains": [
+    {"name": "economy",  "terms": ["fed", "federal", "rate", "recession", "gdp", "economy", "inflation"]},
+    {"name": "politics", "terms": ["trump", "election", "president", "congress", "senate", "vote", "politics"]},
+    {"name": "crypto",   "terms": ["bitcoin", "ethereum", "crypto", "tether", "blockchain", "defi", "nft"]},
+    {"name": "sports",   "terms": ["match", "game", "sports"]},
+    {"name": "health",   "terms": ["covid", "health", "vaccine"]}
+  ],
+  "keywords": [
+    {"keyword": "federal reserve", "triggers": ["fed"]},
+    {"keyword": "interest rate",   "triggers": ["rate"]},
+    {"keyword": "recession",       "triggers": ["recession"]},
+    {"keyword": "crypto",          "triggers": ["crypto"]},
+    {"keyword": "bitcoin",         "triggers": ["bitcoin"]},
+    {"keyword": "ethereum",        "triggers": ["ethereum"]}
+  ]
+})";
+
+SymbolTable domain_names; // noms de domaine à adresse stable (exposés à Rust)
+std::atomic<uint32_t> taxonomy_versions{0};
+
+class MarketTaxonomy {
+private:
+    struct Spec {
+        string default_domain = "other";
+        vector<pair<string, vector<string>>> domains;
+        vector<pair<string, vector<string>>> keywords;
+    };
+    
+    uint32_t version_id;
+    uint32_t default_domain;
+    vector<uint32_t> domain_ids;          // règle -> nom (domain_names)
+    vector<string> keyword_names;
+    vector<string> terms;                 // motifs distincts de l'automate
+    vector<uint32_t> term_rule;           // motif -> première règle de domaine (UINT32_MAX: aucune)
+    vector<vector<uint32_t>> term_keywords; // motif -> mots-clés déclenchés
+    unique_ptr<CaseInsensitiveScanner> scanner;
+    
+    static bool parse_entries(JsonCursor& json, const char* name_key, const char* list_key,
+                              vector<pair<string, vector<string>>>& out) {
+        if (!json.begin_array()) return false;
+        while (json.next_element()) {
+            if (!json.begin_object()) return false;
+            pair<string, vector<string>> entry;
+            string_view key;
+            while (json.next_field(key)) {
+                if (key == name_key) {
+                    json.read_string(entry.first);
+                } else if (key == list_key) {
+                    if (!json.begin_array()) return false;
+                    while (json.next_element()) {
+                        string term;
+                        if (!json.read_string(term)) return false;
+                        if (!term.empty()) entry.second.push_back(move(term));
+                    }
+                } else {
+                    json.skip_value();
+                }
+            }
+            if (entry.first.empty()) return false;
+            out.push_back(move(entry));
+        }
+        return json.ok();
+    }
+    
+    static bool parse(string_view text, Spec& spec) {
+        JsonCursor json(text);
+        if (!json.begin_object()) return false;
+        string_view key;
+        while (json.next_field(key)) {
+            if (key == "default_domain") json.read_string(spec.default_domain);
+            else if (key == "domains") { if (!parse_entries(json, "name", "terms", spec.domains)) return false; }
+            else if (key == "keywords") { if (!parse_entries(json, "keyword", "triggers", spec.keywords)) return false; }
+            else json.skip_value();
+        }
+        return json.ok();
+    }
+    
+    uint32_t term_id(const string& term, unordered_map<string, uint32_t>& ids) {
+        string lower = term;
+        for (char& c : lower) c = (char)tolower((unsigned char)c);
+        auto it = ids.find(lower);
+        if (it != ids.end()) return it->second;
+        uint32_t id = (uint32_t)terms.size();
+        ids.emplace(lower, id);
+        terms.push_back(lower);
+        term_rule.push_back(UINT32_MAX);
+        term_keywords.emplace_back();
+        return id;
+    }
+    
+    explicit MarketTaxonomy(const Spec& spec) : version_id(taxonomy_versions.fetch_add(1) + 1) {
+        default_domain = domain_names.intern(spec.default_domain);
+        unordered_map<string, uint32_t> ids;
+        for (uint32_t rule = 0; rule < spec.domains.size(); rule++) {
+            domain_ids.push_back(domain_names.intern(spec.domains[rule].first));
+            for (const auto& term : spec.domains[rule].second) {
+                uint32_t id = term_id(term, ids);
+                term_rule[id] = min(term_rule[id], rule);
+            }
+        }
+        for (uint32_t k = 0; k < spec.keywords.size(); k++) {
+            keyword_names.push_back(spec.keywords[k].first);
+            for (const auto& trigger : spec.keywords[k].second) {
+                auto& triggered = term_keywords[term_id(trigger, ids)];
+                if (triggered.empty() || triggered.back() != k) triggered.push_back(k);
+            }
+        }
+        scanner = make_unique<CaseInsensitiveScanner>(terms);
+    }
+    
+public:
+    // nullptr si la configuration est invalide
+    static shared_ptr<const MarketTaxonomy> compile(string_view json) {
+        Spec spec;
+        if (!parse(json, spec)) return nullptr;
+        return shared_ptr<const MarketTaxonomy>(new MarketTaxonomy(spec));
+    }
+    
+    uint32_t version() const { return version_id; }
+    const string& default_domain_name() const { return domain_names.name(default_domain); }
+    
+    // Domaine (première règle dont un terme apparaît) et mots-clés, dans l'ordre de la configuration
+    void classify(const string& question, const string& description, string& domain, vector<string>& keywords) const {
+        thread_local string text;
+        text.assign(question);
+        text += ' ';
+        text += description;
+        vector<uint8_t> found = scanner->scan(text.data(), text.size());
+        
+        uint32_t rule = UINT32_MAX;
+        thread_local vector<uint8_t> keyword_found;
+        keyword_found.assign(keyword_names.size(), 0);
+        for (size_t t = 0; t < found.size(); t++) {
+            if (!found[t]) continue;
+            rule = min(rule, term_rule[t]);
+            for (uint32_t k : term_keywords[t]) keyword_found[k] = 1;
+        }
+        
+        domain = domain_names.name(rule == UINT32_MAX ? default_domain : domain_ids[rule]);
+        keywords.clear();
+        for (size_t k = 0; k < keyword_names.size(); k++) {
+            if (keyword_found[k]) keywords.push_back(keyword_names[k]);
+        }
+    }
+};
+
+shared_ptr<const MarketTaxonomy> builtin_market_taxonomy() {
+    static const shared_ptr<const MarketTaxonomy> builtin = MarketTaxonomy::compile(BUILTIN_MARKET_TAXONOMY);
+    return builtin;
+}
+
+shared_ptr<const MarketTaxonomy> installed_taxonomy; // atomic_load / atomic_store
+
+shared_ptr<const MarketTaxonomy> current_taxonomy() {
+    auto taxonomy = std::atomic_load(&installed_taxonomy);
+    return taxonomy ? taxonomy : builtin_market_taxonomy();
+}
+
+// Classe le marché avec la taxonomie courante (domain, keywords, taxonomy_version)
+void classify_market(Market& market, const MarketTaxonomy& taxonomy) {
+    taxonomy.classify(market.question, market.description, market.domain, market.keywords);
+    market.taxonomy_version = taxonomy.version();
+}
+
+// ===== INGESTION DU FLUX CLOB /markets =====
+// Pagination par curseur: la réponse d'une page se termine par "next_cursor", extrait par
+// une recherche depuis la fin sans parser la page. La page suivante est donc demandée par
+// le thread de fetch pendant que la page courante est parsée par l'appelant.
+const char* const CLOB_END_CURSOR = "LTE="; // "-1" en base64: dernière page
+const int MAX_MARKET_PAGES = 1000;
+const size_t MAX_PREFETCHED_PAGES = 2; // pages en attente de parsing
+
+string find_next_cursor(string_view body) {
+    size_t key = body.rfind("\"next_cursor\"");
+    if (key == string_view::npos) return "";
+    string_view rest = body.substr(key + 13);
+    size_t colon = rest.find(':');
+    if (colon == string_view::npos) return "";
+    JsonCursor value(rest.substr(colon + 1));
+    string next;
+    if (!value.read_string(next)) return "";
+    return next;
+}
+
+string clob_markets_page_url(const string& cursor) {
+    if (cursor.empty()) return POLYMARKET_API;
+    string url = POLYMARKET_API + "?next_cursor=";
+    for (char c : cursor) {
+        if (isalnum((unsigned char)c) || c == '-' || c == '_' || c == '.' || c == '~') {
+            url += c;
+        } else {
+            char hex[4];
+            snprintf(hex, sizeof(hex), "%%%02X", (unsigned char)c);
+            url += hex;
+        }
+    }
+    return url;
+}
+
+// Un marché du flux, écrit directement dans out; false si le marché est ignoré
+// (fermé / inactif) ou mal formé
+bool parse_clob_market(JsonCursor& json, vector<Market>& out, const MarketTaxonomy& taxonomy) {
+    if (!json.begin_object()) return false;
+    
+    out.emplace_back();
+    Market& market = out.back();
+    bool active = true, closed = false;
+    double first_price = -1.0, yes_price = -1.0;
+    string outcome, token_id, first_token;
+    
+    string_view key;
+    while (json.next_field(key)) {
+        if (key == "condition_id") {
+            json.read_string(market.id);
+        } else if (key == "question") {
+            json.read_string(market.question);
+        } else if (key == "description") {
+            json.read_string(market.description);
+        } else if (key == "active") {
+            json.read_bool(active);
+        } else if (key == "closed") {
+            json.read_bool(closed);
+        } else if (key == "tokens") {
+            if (!json.begin_array()) break;
+            while (json.next_element()) {
+                if (!json.begin_object()) break;
+                double price = -1.0;
+                outcome.clear();
+                token_id.clear();
+                string_view token_key;
+                while (json.next_field(token_key)) {
+                    if (token_key == "outcome") json.read_string(outcome);
+                    else if (token_key == "price") json.read_number(price);
+                    else if (token_key == "token_id") json.read_string(token_id);
+                    else json.skip_value();
+                }
+                if (first_price < 0.0) {
+                    first_price = price;
+                    first_token = token_id;
+                }
+                if (strcasecmp(outcome.c_str(), "yes") == 0) {
+                    yes_price = price;
+                    market.yes_token_id = token_id;
+                }
+            }
+        } else {
+            json.skip_value();
+        }
+    }
+    
+    if (!json.ok() || market.id.empty() || !active || closed) {
+        out.pop_back();
+        return false;
+    }
+    
+    double price = yes_price >= 0.0 ? yes_price : first_price;
+    market.probability = price >= 0.0 ? price : 0.5;
+    if (market.yes_token_id.empty()) market.yes_token_id = first_token;
+    classify_market(market, taxonomy);
+    market.resolution_source = extract_resolution_source(market.description);
+    market.last_update = chrono::system_clock::now();
+    return true;
+}
+
+// Parse une page {"data": [...], "next_cursor": ...}; false si la page est invalide
+bool parse_clob_market_page(string_view body, vector<Market>& out) {
+    auto taxonomy = current_taxonomy();
+    JsonCursor json(body);
+    if (!json.begin_object()) return false;
+    
+    bool has_data = false;
+    string_view key;
+    while (json.next_field(key)) {
+        if (key == "data") {
+            if (!json.begin_array()) return false;
+            has_data = true;
+            while (json.next_element()) {
+                parse_clob_market(json, out, *taxonomy);
+                if (!json.ok()) return false;
+            }
+        } else {
+            json.skip_value();
+        }
+    }
+    return json.ok() && has_data;
+}
+
+// Fetch des marchés Polymarket (flux CLOB paginé)
+// Renvoie un univers vide si une page échoue: l'appelant garde alors l'univers précédent.
+// times (optionnel): temps de parsing, et attente réseau (le reste) en FETCH
+vector<Market> fetch_polymarket_markets(FastHTTPClient& client, StageTimes* times = nullptr) {
+    vector<Market> fetched_markets;
+    
+    auto start_time = chrono::high_resolution_clock::now();
+    uint64_t start_ns = pipeline_clock_ns();
+    uint64_t parse_ns = 0;
+    
+    // Pages téléchargées en avance par le thread de fetch (au plus MAX_PREFETCHED_PAGES en attente)
+    // stop_fetch: le parsing a échoué, les pages suivantes seraient jetées
+    mutex page_mutex;
+    condition_variable page_ready;
+    condition_variable page_taken;
+    deque<string> pages;
+    bool fetch_done = false;
+    bool fetch_failed = false;
+    bool stop_fetch = false;
+    
+    thread fetcher([&]() {
+        string cursor, url;
+        try {
+            for (int page = 0; page < MAX_MARKET_PAGES; page++) {
+                {
+                    unique_lock<mutex> lock(page_mutex);
+                    page_taken.wait(lock, [&] { return pages.size() < MAX_PREFETCHED_PAGES || stop_fetch; });
+                    if (stop_fetch) break;
+                }
+                url = clob_markets_page_url(cursor);
+                string body = client.GET(url);
+                string next = body.empty() ? "" : find_next_cursor(body);
+                
+                lock_guard<mutex> lock(page_mutex);
+                if (body.empty()) {
+                    fetch_failed = true;
+                    break;
+                }
+                pages.push_back(move(body));
+                page_ready.notify_one();
+                if (next.empty() || next == CLOB_END_CURSOR) break;
+                cursor = move(next);
+            }
+        } catch (const exception& e) {
+            // Une exception ne doit pas sortir du thread (std::terminate): fetch en échec
+            PM_LOG(LogEvent::SOURCE_ERROR, url, e.what());
+            lock_guard<mutex> lock(page_mutex);
+            fetch_failed = true;
+        }
+        lock_guard<mutex> lock(page_mutex);
+        fetch_done = true;
+        page_ready.notify_one();
+    });
+    
+    bool parse_failed = false;
+    while (true) {
+        string body;
+        {
+            unique_lock<mutex> lock(page_mutex);
+            page_ready.wait(lock, [&] { return !pages.empty() || fetch_done; });
+            if (pages.empty()) break;
+            body = move(pages.front());
+            pages.pop_front();
+            page_taken.notify_one();
+        }
+        uint64_t parse_start = pipeline_clock_ns();
+        if (!parse_failed && !parse_clob_market_page(body, fetched_markets)) {
+            parse_failed = true;
+            lock_guard<mutex> lock(page_mutex);
+            stop_fetch = true;
+            pages.clear();
+            page_taken.notify_one();
+        }
+        parse_ns += pipeline_clock_ns() - parse_start;
+    }
+    fetcher.join();
+    if (times) {
+        times->add(PipelineStage::PARSE, parse_ns);
+        times->add(PipelineStage::FETCH, pipeline_clock_ns() - start_ns - parse_ns);
+    }
+    
+    if (fetch_failed || parse_failed) fetched_markets.clear();
+    
+    auto end_time = chrono::high_resolution_clock::now();
+    auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time);
+    
+    PM_LOG(LogEvent::MARKETS_FETCHED, fetched_markets.size(), duration.count());
+    
+    return fetched_markets;
+}
+
+// Construction du SourceData à partir d'un scan terminé
+// Si previous est fourni et que la page n'a pas changé (304 ou même empreinte),
+// les found_keywords précédents sont conservés
+SourceData finalize_source_scan(const string& url, const HTTPResponse& response, const SourceScan& scan,
+                                long duration_ms, const SourceData* previous = nullptr) {
+    uint64_t keyword_sig = scan.keyword_signature;
+    bool can_reuse = can_revalidate(previous, keyword_sig);
+    
+    if (response.status == 304 && can_reuse) {
+        SourceData data = *previous;
+        data.not_modified = true;
+        data.last_check = chrono::system_clock::now();
+        if (!response.etag.empty()) data.etag = response.etag;
+        if (!response.last_modified.empty()) data.last_modified = response.last_modified;
+        PM_LOG(LogEvent::SOURCE_NOT_MODIFIED, url, duration_ms);
+        return data;
+    }
+    
+    SourceData data;
+    data.url = url;
+    
+    if (scan.bytes == 0) {
+        data.accessible = false;
+        data.error = "Empty response";
+        return data;
+    }
+    
+    data.accessible = true;
+    data.content_length = scan.bytes;
+    data.last_check = chrono::system_clock::now();
+    data.etag = response.etag;
+    data.last_modified = response.last_modified;
+    data.truncated = scan.truncated;
+    data.content_hash = scan.content_hash;
+    data.keyword_signature = keyword_sig;
+    
+    if (can_reuse && data.content_hash != 0 && previous->content_hash == data.content_hash) {
+        data.found_keywords = previous->found_keywords;
+        data.not_modified = true;
+        PM_LOG(LogEvent::SOURCE_UNCHANGED, url, data.content_length, duration_ms);
+        return data;
+    }
+    
+    data.found_keywords = scan.found_keywords;
+    
+    PM_LOG(LogEvent::SOURCE_OK, url, data.content_length, duration_ms, scan.truncated ? 1 : 0);
+    
+    return data;
+}
+
+// Analyse d'une réponse source déjà téléchargée (recherche des mots-clés)
+SourceData analyze_source_response(const string& url, const HTTPResponse& response, const vector<string>& keywords,
+                                   long duration_ms, const SourceData* previous = nullptr) {
+    auto scanner = ci_scanner_for(keywords);
+    SourceScan scan;
+    scan.keyword_signature = scanner->keyword_signature();
+    scan.bytes = response.body.size();
+    scan.content_hash = fast_content_hash(response.body);
+    scan.found_keywords = scanner->found_keywords(response.body.data(), response.body.size());
+    return finalize_source_scan(url, response, scan, duration_ms, previous);
+}
+
+// Monitoring des sources de résolution
+SourceData monitor_resolution_source(FastHTTPClient& client, const string& url, const vector<string>& keywords,
+                                     const SourceData* previous = nullptr) {
+    if (!can_revalidate(previous, keyword_set_signature(keywords))) previous = nullptr;
+    
+    auto start_time = chrono::high_resolution_clock::now();
+    HTTPResponse response = previous ? client.GET_conditional(url, previous->etag, previous->last_modified)
+                                     : client.GET_conditional(url, "", "");
+    auto end_time = chrono::high_resolution_clock::now();
+    
+    auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time);
+    return analyze_source_response(url, response, keywords, duration.count(), previous);
+}
+
+// Poller multiplexé: toutes les sources en vol sur un seul thread (curl multi)
+// Au plus MAX_CONCURRENT_REQUESTS transferts simultanés, REQUEST_TIMEOUT_MS par requête
+// Les easy handles sont recyclés entre les cycles pour garder connexions et sessions TLS
+class MultiSourcePoller {
+private:
+    struct Transfer {
+        CURL* easy = nullptr;
+        size_t index = 0;
+        HTTPResponse response;     // statut et validateurs, le corps n'est pas conservé
+        KeywordStream scan;
+        struct curl_slist* request_headers = nullptr;
+        const SourceData* previous = nullptr;
+        chrono::high_resolution_clock::time_point start;
+    };
+    
+    CURLM* multi;
+    CURLSH* share;
+    struct curl_slist* headers;
+    vector<CURL*> idle_handles;
+    mutex poll_mutex;
+    
+    CURL* acquire_handle() {
+        if (!idle_handles.empty()) {
+            CURL* easy = idle_handles.back();
+            idle_handles.pop_back();
+            return easy;
+        }
+        
+        CURL* easy = curl_easy_init();
+        if (!easy) return nullptr;
+        
+        curl_easy_setopt(easy, CURLOPT_WRITEFUNCTION, StreamingWriteCallback);
+        curl_easy_setopt(easy, CURLOPT_HEADERFUNCTION, HeaderCallback);
+        curl_easy_setopt(easy, CURLOPT_TIMEOUT_MS, (long)REQUEST_TIMEOUT_MS);
+        curl_easy_setopt(easy, CURLOPT_CONNECTTIMEOUT_MS, 3000L);
+        apply_persistent_connection_opts(easy, share);
+        return easy;
+    }
+    
+    void start_transfer(Transfer& t, const string& url, const shared_ptr<const KeywordAutomaton>& automaton) {
+        t.easy = acquire_handle();
+        if (!t.easy) return;
+        
+        t.request_headers = nullptr;
+        for (struct curl_slist* h = headers; h; h = h->next) {
+            t.request_headers = curl_slist_append(t.request_headers, h->data);
+        }
+        if (t.previous) {
+            t.request_headers = append_conditional_headers(t.request_headers, t.previous->etag, t.previous->last_modified);
+        }
+        
+        t.start = chrono::high_resolution_clock::now();
+        curl_easy_setopt(t.easy, CURLOPT_URL, url.c_str());
+        curl_easy_setopt(t.easy, CURLOPT_HTTPHEADER, t.request_headers);
+        t.scan = KeywordStream(automaton, (StreamAbortMode)source_stream_abort_mode.load(memory_order_relaxed));
+        curl_easy_setopt(t.easy, CURLOPT_WRITEDATA, &t.scan);
+        curl_easy_setopt(t.easy, CURLOPT_HEADERDATA, &t.response);
+        curl_easy_setopt(t.easy, CURLOPT_PRIVATE, &t);
+        curl_multi_add_handle(multi, t.easy);
+    }
+    
+public:
+    explicit MultiSourcePoller(CURLSH* share_handle = nullptr) {
+        multi = curl_multi_init();
+        share = share_handle;
+        headers = nullptr;
+        headers = curl_slist_append(headers, "User-Agent: Polymarket-Bot/1.0");
+        
+        if (multi) {
+            curl_multi_setopt(multi, CURLMOPT_MAX_TOTAL_CONNECTIONS, (long)MAX_CONCURRENT_REQUESTS);
+            curl_multi_setopt(multi, CURLMOPT_PIPELINING, (long)CURLPIPE_MULTIPLEX);
+        }
+    }
+    
+    ~MultiSourcePoller() {
+        for (CURL* easy : idle_handles) curl_easy_cleanup(easy);
+        if (multi) curl_multi_cleanup(multi);
+        if (headers) curl_slist_free_all(headers);
+    }
+    
+    MultiSourcePoller(const MultiSourcePoller&) = delete;
+    MultiSourcePoller& operator=(const MultiSourcePoller&) = delete;
+    
+    // Résultats dans l'ordre des URLs en entrée
+    // previous: état du cycle précédent, utilisé pour le GET conditionnel
+    vector<SourceData> poll(const vector<string>& urls, const vector<string>& keywords,
+                            const map<string, SourceData>* previous = nullptr) {
+        lock_guard<mutex> lock(poll_mutex);
+        vector<SourceData> results(urls.size());
+        if (!multi) {
+            for (size_t i = 0; i < urls.size(); i++) {
+                results[i].url = urls[i];
+                results[i].error = "curl_multi_init failed";
+            }
+            return results;
+        }
+        
+        vector<Transfer> transfers(urls.size());
+        auto automaton = keyword_automaton_for(keywords);
+        uint64_t keyword_sig = automaton->keyword_signature();
+        size_t next = 0;
+        int in_flight = 0;
+        
+        auto launch_pending = [&]() {
+            while (next < urls.size() && in_flight < MAX_CONCURRENT_REQUESTS) {
+                Transfer& t = transfers[next];
+                t.index = next;
+                if (previous) {
+                    auto it = previous->find(urls[next]);
+                    if (it != previous->end() && can_revalidate(&it->second, keyword_sig)) t.previous = &it->second;
+                }
+                start_transfer(t, urls[next], automaton);
+                if (t.easy) {
+                    in_flight++;
+                } else {
+                    results[next].url = urls[next];
+                    results[next].error = "curl_easy_init failed";
+                }
+                next++;
+            }
+        };
+        
+        launch_pending();
+        
+        while (in_flight > 0) {
+            int running = 0;
+            curl_multi_perform(multi, &running);
+            
+            int msgs_left = 0;
+            while (CURLMsg* msg = curl_multi_info_read(multi, &msgs_left)) {
+                if (msg->msg != CURLMSG_DONE) continue;
+                
+                Transfer* t = nullptr;
+                curl_easy_getinfo(msg->easy_handle, CURLINFO_PRIVATE, (char**)&t);
+                auto end_time = chrono::high_resolution_clock::now();
+                auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - t->start);
+                
+                const string& url = urls[t->index];
+                // CURLE_WRITE_ERROR attendu quand le scan a demandé l'arrêt anticipé
+                bool aborted = msg->data.result == CURLE_WRITE_ERROR && t->scan.aborted;
+                record_transfer_latency(t->easy, msg->data.result, !aborted);
+                if (msg->data.result == CURLE_OK || aborted) {
+                    curl_easy_getinfo(t->easy, CURLINFO_RESPONSE_CODE, &t->response.status);
+                    results[t->index] = finalize_source_scan(url, t->response, scan_result(t->scan), duration.count(), t->previous);
+                } else {
+                    results[t->index].url = url;
+                    results[t->index].error = curl_easy_strerror(msg->data.result);
+                    PM_LOG(LogEvent::SOURCE_ERROR, url, results[t->index].error);
+                }
+                
+                curl_multi_remove_handle(multi, t->easy);
+                idle_handles.push_back(t->easy);
+                curl_slist_free_all(t->request_headers);
+                t->request_headers = nullptr;
+                t->easy = nullptr;
+                t->response = HTTPResponse();
+                t->scan = KeywordStream();
+                in_flight--;
+            }
+            
+            launch_pending();
+            
+            if (in_flight > 0) {
+                curl_multi_poll(multi, nullptr, 0, 100, nullptr);
+            }
+        }
+        
+        return results;
+    }
+};
+
+// Pool de connexions persistant, durée de vie du process
+// Un share handle curl porte le cache DNS, les sessions TLS et le cache de connexions,
+// partagés par les clients du pool et par le poller multiplexé
+const size_t HTTP_POOL_SIZE = 8;
+
+class HTTPConnectionPool {
+private:
+    CURLSH* share = nullptr;
+    mutex share_locks[CURL_LOCK_DATA_LAST];
+    vector<unique_ptr<FastHTTPClient>> idle_clients;
+    mutex pool_mutex;
+    unique_ptr<MultiSourcePoller> poller;
+    once_flag init_flag;
+    bool ready = false;
+    
+    static void lock_cb(CURL*, curl_lock_data data, curl_lock_access, void* userptr) {
+        static_cast<HTTPConnectionPool*>(userptr)->share_locks[data].lock();
+    }
+    
+    static void unlock_cb(CURL*, curl_lock_data data, void* userptr) {
+        static_cast<HTTPConnectionPool*>(userptr)->share_locks[data].unlock();
+    }
+    
+    void do_init() {
+        if (curl_global_init(CURL_GLOBAL_ALL) != CURLE_OK) return;
+        
+        share = curl_share_init();
+        if (share) {
+            curl_share_setopt(share, CURLSHOPT_LOCKFUNC, lock_cb);
+            curl_share_setopt(share, CURLSHOPT_UNLOCKFUNC, unlock_cb);
+            curl_share_setopt(share, CURLSHOPT_USERDATA, this);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_DNS);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_SSL_SESSION);
+            curl_share_setopt(share, CURLSHOPT_SHARE, CURL_LOCK_DATA_CONNECT);
+        }
+        
+        for (size_t i = 0; i < HTTP_POOL_SIZE; i++) {
+            idle_clients.push_back(make_unique<FastHTTPClient>(share));
+        }
+        poller = make_unique<MultiSourcePoller>(share);
+        ready = true;
+    }
+    
+public:
+    HTTPConnectionPool() = default;
+    HTTPConnectionPool(const HTTPConnectionPool&) = delete;
+    HTTPConnectionPool& operator=(const HTTPConnectionPool&) = delete;
+    
+    ~HTTPConnectionPool() {
+        if (!ready) return;
+        // Les handles doivent être libérés avant le share handle
+        poller.reset();
+        idle_clients.clear();
+        if (share) curl_share_cleanup(share);
+        curl_global_cleanup();
+    }
+    
+    // Idempotent: appelé par init_polymarket_core() et en secours par update_market_data()
+    bool init() {
+        call_once(init_flag, [this]() { do_init(); });
+        return ready;
+    }
+    
+    // nullptr si l'initialisation de curl a échoué
+    unique_ptr<FastHTTPClient> acquire() {
+        if (!init()) return nullptr;
+        {
+            lock_guard<mutex> lock(pool_mutex);
+            if (!idle_clients.empty()) {
+                auto client = move(idle_clients.back());
+                idle_clients.pop_back();
+                return client;
+            }
+        }
+        // Pool vide: client supplémentaire, rendu au pool ensuite
+        return make_unique<FastHTTPClient>(share);
+    }
+    
+    void release(unique_ptr<FastHTTPClient> client) {
+        if (!client) return;
+        lock_guard<mutex> lock(pool_mutex);
+        idle_clients.push_back(move(client));
+    }
+    
+    // nullptr si l'initialisation de curl a échoué
+    MultiSourcePoller* source_poller() {
+        return init() ? poller.get() : nullptr;
+    }
+};
+
+HTTPConnectionPool http_pool;
+
+// Emprunt RAII d'un client du pool
+class PooledClient {
+private:
+    unique_ptr<FastHTTPClient> client;
+    
+public:
+    PooledClient() : client(http_pool.acquire()) {}
+    ~PooledClient() { http_pool.release(move(client)); }
+    
+    PooledClient(const PooledClient&) = delete;
+    PooledClient& operator=(const PooledClient&) = delete;
+    
+    explicit operator bool() const { return client != nullptr; }
+    FastHTTPClient& operator*() { return *client; }
+    FastHTTPClient* operator->() { return client.get(); }
+};
+
+// FORMULE ROI PROFESSIONNELLE POLYMARKET (frais 3% sur le profit uniquement)
+// Noyau pur: aucune E/S, aucun état global, évaluable à la compilation
+struct RoiBreakdown {
+    bool bet_on_yes;   // prix < 50% -> on parie "OUI"
+    double buy_price;  // p: prix d'achat effectif (avec rattrapage), borné à [0.05, 0.95]
+    double pi_star;    // seuil break-even exprimé en proba YES
+    double roi;
+};
+
+// ROI pour un prix d'achat p connu du côté parié (modèle ou VWAP du carnet)
+constexpr RoiBreakdown roi_at_buy_price(bool bet_on_yes, double p, double fee, double fixed_cost,
+                                        double pi_bet) noexcept {
+    const double g = fixed_cost;
+    
+    // ROI = [π_côté*(1-p)*(1-f) - (1-π_côté)*p - g] / (p+g)
+    const double expected_profit = pi_bet * (1.0 - p) * (1.0 - fee) - (1.0 - pi_bet) * p - g;
+    const double threshold = (p + g) / (p + (1.0 - p) * (1.0 - fee));
+    
+    return RoiBreakdown{bet_on_yes, p, bet_on_yes ? threshold : 1.0 - threshold, expected_profit / (p + g)};
+}
+
+constexpr RoiBreakdown roi_kernel_breakdown(double current_price, double fee, double catchup_speed,
+                                            double action_time, double fixed_cost, double pi_yes) noexcept {
+    // LOGIQUE MARCHÉ BINAIRE: OUI si prix < 50%, sinon NON (prix du NO = 1 - prix)
+    const bool bet_on_yes = current_price < 0.5;
+    const double side_price = bet_on_yes ? current_price : 1.0 - current_price;
+    const double pi_bet = bet_on_yes ? pi_yes : 1.0 - pi_yes;
+    
+    // Prix d'achat = prix du côté parié + (vitesse_rattrapage × temps_action), borné
+    const double p = std::min(std::max(side_price + catchup_speed * action_time, 0.05), 0.95);
+    return roi_at_buy_price(bet_on_yes, p, fee, fixed_cost, pi_bet);
+}
+
+constexpr double roi_kernel(double current_price, double fee, double catchup_speed,
+                            double action_time, double fixed_cost, double pi_yes) noexcept {
+    return roi_kernel_breakdown(current_price, fee, catchup_speed, action_time, fixed_cost, pi_yes).roi;
+}
+
+// Contexte ROI ré-entrant: tous les paramètres d'un calcul, passés par valeur (aucun état global).
+// Le live lit le sien dans live_roi (configure_roi_params); rejeu et calibrage ont les leurs.
+struct RoiContext {
+    double fee = 0.03;           // 3% fees on profit (Polymarket standard)
+    double catchup_speed = 0.8;  // 80% per second (optimized for speed)
+    double action_time = 0.025;  // 25ms (optimized HFT latency)
+    double fixed_cost = 0.0005;  // Reduced fixed costs for HFT
+    double pi_yes = 0.55;        // π = proba subjective que l'événement soit YES (55%)
+    
+    constexpr RoiBreakdown breakdown(double current_price) const noexcept {
+        return roi_kernel_breakdown(current_price, fee, catchup_speed, action_time, fixed_cost, pi_yes);
+    }
+    constexpr double roi(double current_price) const noexcept { return breakdown(current_price).roi; }
+};
+
+static_assert(RoiContext{}.breakdown(0.3).bet_on_yes, "roi_kernel must stay usable in constant expressions");
+
+// Paramètres du pipeline live: écrits rarement (configure_roi_params), lus à chaque calcul.
+// Séquence impaire pendant une écriture: le lecteur recommence, il ne voit jamais un mélange
+// d'anciens et de nouveaux paramètres, et ne prend aucun verrou.
+class LiveRoiContext {
+private:
+    std::atomic<uint32_t> sequence{0};
+    std::atomic<double> fee, catchup_speed, action_time, fixed_cost, pi_yes;
+    std::mutex writer_mutex;
+    
+    void publish(const RoiContext& context) {
+        uint32_t seq = sequence.load(std::memory_order_relaxed);
+        sequence.store(seq + 1, std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_release);
+        fee.store(context.fee, std::memory_order_relaxed);
+        catchup_speed.store(context.catchup_speed, std::memory_order_relaxed);
+        action_time.store(context.action_time, std::memory_order_relaxed);
+        fixed_cost.store(context.fixed_cost, std::memory_order_relaxed);
+        pi_yes.store(context.pi_yes, std::memory_order_relaxed);
+        sequence.store(seq + 2, std::memory_order_release);
+    }
+    
+public:
+    LiveRoiContext() { publish(RoiContext{}); }
+    
+    RoiContext load() const {
+        while (true) {
+            uint32_t before = sequence.load(std::memory_order_acquire);
+            if (before & 1) continue;
+            RoiContext context;
+            context.fee = fee.load(std::memory_order_relaxed);
+            context.catchup_speed = catchup_speed.load(std::memory_order_relaxed);
+            context.action_time = action_time.load(std::memory_order_relaxed);
+            context.fixed_cost = fixed_cost.load(std::memory_order_relaxed);
+            context.pi_yes = pi_yes.load(std::memory_order_relaxed);
+            std::atomic_thread_fence(std::memory_order_acquire);
+            if (sequence.load(std::memory_order_relaxed) == before) return context;
+        }
+    }
+    
+    // Modification sous verrou écrivain: fn(RoiContext&) sur les paramètres courants
+    template <typename Fn>
+    void update(Fn&& fn) {
+        std::lock_guard<std::mutex> lock(writer_mutex);
+        RoiContext context = load();
+        fn(context);
+        publish(context);
+    }
+};
+
+LiveRoiContext live_roi;
+
+// Noyaux ROI vectorisés pour le calcul par lot: mêmes opérations, dans le même ordre,
+// que roi_kernel (résultats identiques au scalaire). catchup / action_time par marché optionnels,
+// sinon ceux du contexte.
+
+using RoiBatchKernel = void (*)(const RoiContext& params, const double* prices, size_t n,
+                                const double* catchup_speeds, const double* action_times,
+                                double* out_roi, uint8_t* out_bet_yes);
+
+void roi_batch_scalar(const RoiContext& params, const double* prices, size_t n,
+                      const double* catchup_speeds, const double* action_times,
+                      double* out_roi, uint8_t* out_bet_yes) {
+    for (size_t i = 0; i < n; i++) {
+        RoiBreakdown r = roi_kernel_breakdown(prices[i], params.fee,
+                                              catchup_speeds ? catchup_speeds[i] : params.catchup_speed,
+                                              action_times ? action_times[i] : params.action_time,
+                                              params.fixed_cost, params.pi_yes);
+        out_roi[i] = r.roi;
+        if (out_bet_yes) out_bet_yes[i] = r.bet_on_yes;
+    }
+}
+
+#if defined(__x86_64__)
+void roi_batch_sse2(const RoiContext& params, const double* prices, size_t n,
+                    const double* catchup_speeds, const double* action_times,
+                    double* out_roi, uint8_t* out_bet_yes) {
+    const __m128d one = _mm_set1_pd(1.0), half = _mm_set1_pd(0.5);
+    const __m128d lo = _mm_set1_pd(0.05), hi = _mm_set1_pd(0.95);
+    const __m128d one_minus_fee = _mm_set1_pd(1.0 - params.fee);
+    const __m128d g = _mm_set1_pd(params.fixed_cost);
+    const __m128d pi_yes = _mm_set1_pd(params.pi_yes), pi_no = _mm_set1_pd(1.0 - params.pi_yes);
+    const __m128d speed = _mm_set1_pd(params.catchup_speed), time = _mm_set1_pd(params.action_time);
+    
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        __m128d price = _mm_loadu_pd(prices + i);
+        __m128d yes = _mm_cmplt_pd(price, half);
+        // Sélection sans branche: (mask & a) | (~mask & b)
+        __m128d side = _mm_or_pd(_mm_and_pd(yes, price), _mm_andnot_pd(yes, _mm_sub_pd(one, price)));
+        __m128d pi_bet = _mm_or_pd(_mm_and_pd(yes, pi_yes), _mm_andnot_pd(yes, pi_no));
+        __m128d c = catchup_speeds ? _mm_loadu_pd(catchup_speeds + i) : speed;
+        __m128d t = action_times ? _mm_loadu_pd(action_times + i) : time;
+        __m128d p = _mm_min_pd(_mm_max_pd(_mm_add_pd(side, _mm_mul_pd(c, t)), lo), hi);
+        __m128d profit = _mm_sub_pd(_mm_sub_pd(_mm_mul_pd(_mm_mul_pd(pi_bet, _mm_sub_pd(one, p)), one_minus_fee),
+                                               _mm_mul_pd(_mm_sub_pd(one, pi_bet), p)), g);
+        _mm_storeu_pd(out_roi + i, _mm_div_pd(profit, _mm_add_pd(p, g)));
+        if (out_bet_yes) {
+            int mask = _mm_movemask_pd(yes);
+            out_bet_yes[i] = mask & 1;
+            out_bet_yes[i + 1] = (mask >> 1) & 1;
+        }
+    }
+    roi_batch_scalar(params, prices + i, n - i, catchup_speeds ? catchup_speeds + i : nullptr,
+                     action_times ? action_times + i : nullptr, out_roi + i, out_bet_yes ? out_bet_yes + i : nullptr);
+}
+
+__attribute__((target("avx2")))
+void roi_batch_avx2(const RoiContext& params, const double* prices, size_t n,
+                    const double* catchup_speeds, const double* action_times,
+                    double* out_roi, uint8_t* out_bet_yes) {
+    const __m256d one = _mm256_set1_pd(1.0), half = _mm256_set1_pd(0.5);
+    const __m256d lo = _mm256_set1_pd(0.05), hi = _mm256_set1_pd(0.95);
+    const __m256d one_minus_fee = _mm256_set1_pd(1.0 - params.fee);
+    const __m256d g = _mm256_set1_pd(params.fixed_cost);
+    const __m256d pi_yes = _mm256_set1_pd(params.pi_yes), pi_no = _mm256_set1_pd(1.0 - params.pi_yes);
+    const __m256d speed = _mm256_set1_pd(params.catchup_speed), time = _mm256_set1_pd(params.action_time);
+    
+    size_t i = 0;
+    for (; i + 4 <= n; i += 4) {
+        __m256d price = _mm256_loadu_pd(prices + i);
+        __m256d yes = _mm256_cmp_pd(price, half, _CMP_LT_OQ);
+        __m256d side = _mm256_blendv_pd(_mm256_sub_pd(one, price), price, yes);
+        __m256d pi_bet = _mm256_blendv_pd(pi_no, pi_yes, yes);
+        __m256d c = catchup_speeds ? _mm256_loadu_pd(catchup_speeds + i) : speed;
+        __m256d t = action_times ? _mm256_loadu_pd(action_times + i) : time;
+        __m256d p = _mm256_min_pd(_mm256_max_pd(_mm256_add_pd(side, _mm256_mul_pd(c, t)), lo), hi);
+        __m256d profit = _mm256_sub_pd(_mm256_sub_pd(_mm256_mul_pd(_mm256_mul_pd(pi_bet, _mm256_sub_pd(one, p)), one_minus_fee),
+                                                     _mm256_mul_pd(_mm256_sub_pd(one, pi_bet), p)), g);
+        _mm256_storeu_pd(out_roi + i, _mm256_div_pd(profit, _mm256_add_pd(p, g)));
+        if (out_bet_yes) {
+            int mask = _mm256_movemask_pd(yes);
+            for (int lane = 0; lane < 4; lane++) out_bet_yes[i + lane] = (mask >> lane) & 1;
+        }
+    }
+    roi_batch_scalar(params, prices + i, n - i, catchup_speeds ? catchup_speeds + i : nullptr,
+                     action_times ? action_times + i : nullptr, out_roi + i, out_bet_yes ? out_bet_yes + i : nullptr);
+}
+#endif
+
+#if defined(__aarch64__)
+void roi_batch_neon(const RoiContext& params, const double* prices, size_t n,
+                    const double* catchup_speeds, const double* action_times,
+                    double* out_roi, uint8_t* out_bet_yes) {
+    const float64x2_t one = vdupq_n_f64(1.0), half = vdupq_n_f64(0.5);
+    const float64x2_t lo = vdupq_n_f64(0.05), hi = vdupq_n_f64(0.95);
+    const float64x2_t one_minus_fee = vdupq_n_f64(1.0 - params.fee);
+    const float64x2_t g = vdupq_n_f64(params.fixed_cost);
+    const float64x2_t pi_yes = vdupq_n_f64(params.pi_yes), pi_no = vdupq_n_f64(1.0 - params.pi_yes);
+    const float64x2_t speed = vdupq_n_f64(params.catchup_speed), time = vdupq_n_f64(params.action_time);
+    
+    size_t i = 0;
+    for (; i + 2 <= n; i += 2) {
+        float64x2_t price = vld1q_f64(prices + i);
+        uint64x2_t yes = vcltq_f64(price, half);
+        float64x2_t side = vbslq_f64(yes, price, vsubq_f64(one, price));
+        float64x2_t pi_bet = vbslq_f64(yes, pi_yes, pi_no);
+        float64x2_t c = catchup_speeds ? vld1q_f64(catchup_speeds + i) : speed;
+        float64x2_t t = action_times ? vld1q_f64(action_times + i) : time;
+        float64x2_t p = vminq_f64(vmaxq_f64(vaddq_f64(side, vmulq_f64(c, t)), lo), hi);
+        float64x2_t profit = vsubq_f64(vsubq_f64(vmulq_f64(vmulq_f64(pi_bet, vsubq_f64(one, p)), one_minus_fee),
+                                                 vmulq_f64(vsubq_f64(one, pi_bet), p)), g);
+        vst1q_f64(out_roi + i, vdivq_f64(profit, vaddq_f64(p, g)));
+        if (out_bet_yes) {
+            out_bet_yes[i] = vgetq_lane_u64(yes, 0) & 1;
+            out_bet_yes[i + 1] = vgetq_lane_u64(yes, 1) & 1;
+        }
+    }
+    roi_batch_scalar(params, prices + i, n - i, catchup_speeds ? catchup_speeds + i : nullptr,
+                     action_times ? action_times + i : nullptr, out_roi + i, out_bet_yes ? out_bet_yes + i : nullptr);
+}
+#endif
+
+RoiBatchKernel select_roi_batch_kernel() {
+#if defined(__x86_64__)
+    return cpu_supports_avx2() ? roi_batch_avx2 : roi_batch_sse2;
+#elif defined(__aarch64__)
+    return roi_batch_neon;
+#else
+    return roi_batch_scalar;
+#endif
+}
+
+// Trace ROI optionnelle et limitée en débit (désactivée par défaut)
+// Sink installé via set_roi_trace_sink(); nullptr avec un débit > 0 = stderr
+using RoiTraceSink = void (*)(const char* line);
+
+std::atomic<RoiTraceSink> roi_trace_sink{nullptr};
+std::atomic<int> roi_trace_max_per_second{0};
+std::atomic<int64_t> roi_trace_window{0};
+std::atomic<int> roi_trace_count{0};
+
+void roi_trace_stderr(const char* line) {
+    fputs(line, stderr);
+}
+
+bool roi_trace_admit() {
+    int max_per_second = roi_trace_max_per_second.load(std::memory_order_relaxed);
+    if (max_per_second <= 0) return false;
+    
+    int64_t now = chrono::duration_cast<chrono::seconds>(chrono::steady_clock::now().time_since_epoch()).count();
+    int64_t window = roi_trace_window.load(std::memory_order_relaxed);
+    if (window != now && roi_trace_window.compare_exchange_strong(window, now, std::memory_order_relaxed)) {
+        roi_trace_count.store(0, std::memory_order_relaxed);
+    }
+    return roi_trace_count.fetch_add(1, std::memory_order_relaxed) < max_per_second;
+}
+
+void roi_trace(double current_price, double pi_yes, const RoiBreakdown& r) {
+    if (!roi_trace_admit()) return;
+    
+    char line[192];
+    snprintf(line, sizeof(line),
+             "[ROI PRO] Current: %.2f%%, Bet: %s, Buy price (p): %.2f%%, Confidence (π): %.2f%%, Break-even (π*): %.2f%%, ROI: %.2f%%\n",
+             current_price * 100, r.bet_on_yes ? "YES" : "NO", r.buy_price * 100, pi_yes * 100, r.pi_star * 100, r.roi * 100);
+    
+    RoiTraceSink sink = roi_trace_sink.load(std::memory_order_acquire);
+    (sink ? sink : roi_trace_stderr)(line);
+}
+
+double calculate_real_roi(const RoiContext& context, double current_price) {
+    RoiBreakdown r = context.breakdown(current_price);
+    roi_trace(current_price, context.pi_yes, r);
+    return r.roi;
+}
+
+// ===== CARNET D'ORDRES L2 =====
+// Prix en ticks entiers (1e-4), niveaux contigus triés du pire au meilleur: le meilleur prix
+// est en fin de tableau (accès O(1)), et les mises à jour, presque toujours près du sommet,
+// ne déplacent que quelques éléments. Le parcours de profondeur reste dans le cache.
+constexpr double BOOK_TICKS_PER_UNIT = 10000.0;
+
+struct BookLevel {
+    uint32_t tick;
+    double size;
+};
+
+// Résultat d'un remplissage simulé de shares parts
+struct BookFill {
+    double filled = 0.0;  // parts disponibles (<= demandées)
+    double cost = 0.0;    // somme prix × taille sur les niveaux traversés
+    double worst_price = 0.0;
+    
+    bool complete(double shares) const { return filled >= shares; }
+    double vwap() const { return filled > 0.0 ? cost / filled : 0.0; }
+};
+
+class L2Book {
+private:
+    vector<BookLevel> bids; // tick croissant: meilleur bid en fin
+    vector<BookLevel> asks; // tick décroissant: meilleur ask en fin
+    
+    static vector<BookLevel>& side_levels(L2Book& book, bool is_bid) { return is_bid ? book.bids : book.asks; }
+    
+    // Position du tick dans le côté (ordre "pire -> meilleur")
+    static vector<BookLevel>::iterator locate(vector<BookLevel>& levels, bool is_bid, uint32_t tick) {
+        if (is_bid) {
+            return lower_bound(levels.begin(), levels.end(), tick,
+                               [](const BookLevel& level, uint32_t t) { return level.tick < t; });
+        }
+        return lower_bound(levels.begin(), levels.end(), tick,
+                           [](const BookLevel& level, uint32_t t) { return level.tick > t; });
+    }
+    
+    static BookFill walk(const vector<BookLevel>& levels, double shares) {
+        BookFill fill;
+        for (auto it = levels.rbegin(); it != levels.rend() && fill.filled < shares; ++it) {
+            double take = min(it->size, shares - fill.filled);
+            double price = it->tick / BOOK_TICKS_PER_UNIT;
+            fill.filled += take;
+            fill.cost += take * price;
+            fill.worst_price = price;
+        }
+        return fill;
+    }
+    
+public:
+    static uint32_t to_tick(double price) {
+        return (uint32_t)llround(min(max(price, 0.0), 1.0) * BOOK_TICKS_PER_UNIT);
+    }
+    
+    void clear() {
+        bids.clear();
+        asks.clear();
+    }
+    
+    // Taille 0: suppression du niveau
+    void set_level(bool is_bid, double price, double size) {
+        vector<BookLevel>& levels = side_levels(*this, is_bid);
+        uint32_t tick = to_tick(price);
+        auto it = locate(levels, is_bid, tick);
+        bool found = it != levels.end() && it->tick == tick;
+        if (size > 0.0) {
+            if (found) it->size = size;
+            else levels.insert(it, {tick, size});
+        } else if (found) {
+            levels.erase(it);
+        }
+    }
+    
+    // Remplace tout un côté (instantané); prices/sizes dans un ordre quelconque
+    void replace(bool is_bid, const double* prices, const double* sizes, size_t n) {
+        vector<BookLevel>& levels = side_levels(*this, is_bid);
+        levels.clear();
+        for (size_t i = 0; i < n; i++) set_level(is_bid, prices[i], sizes[i]);
+    }
+    
+    bool has_bid() const { return !bids.empty(); }
+    bool has_ask() const { return !asks.empty(); }
+    double best_bid() const { return bids.empty() ? 0.0 : bids.back().tick / BOOK_TICKS_PER_UNIT; }
+    double best_ask() const { return asks.empty() ? 0.0 : asks.back().tick / BOOK_TICKS_PER_UNIT; }
+    size_t depth(bool is_bid) const { return is_bid ? bids.size() : asks.size(); }
+    
+    // Prix milieu; un seul côté présent: ce côté; carnet vide: -1
+    double mid() const {
+        if (!bids.empty() && !asks.empty()) return (bids.back().tick + asks.back().tick) / (2.0 * BOOK_TICKS_PER_UNIT);
+        if (!bids.empty()) return best_bid();
+        if (!asks.empty()) return best_ask();
+        return -1.0;
+    }
+    
+    // Achat de shares parts "Yes" (traverse les asks) / vente (traverse les bids)
+    BookFill fill_buy(double shares) const { return walk(asks, shares); }
+    BookFill fill_sell(double shares) const { return walk(bids, shares); }
+};
+
+// ROI d'une mise de stake parts au VWAP réel du carnet "Yes".
+// Pari OUI: achat des asks; pari NON: le NO s'achète à 1 - bid (contrepartie des bids).
+// Le rattrapage (catchup × action_time) s'ajoute au VWAP comme dans le modèle.
+// false si le carnet ne peut pas absorber la mise.
+bool depth_roi(const L2Book& book, bool bet_on_yes, double stake, const RoiContext& context, double& roi) {
+    if (stake <= 0.0) return false;
+    BookFill fill = bet_on_yes ? book.fill_buy(stake) : book.fill_sell(stake);
+    if (!fill.complete(stake)) return false;
+    
+    double side_price = bet_on_yes ? fill.vwap() : 1.0 - fill.vwap();
+    double p = min(max(side_price + context.catchup_speed * context.action_time, 1.0 / BOOK_TICKS_PER_UNIT),
+                   1.0 - 1.0 / BOOK_TICKS_PER_UNIT);
+    double pi_bet = bet_on_yes ? context.pi_yes : 1.0 - context.pi_yes;
+    roi = roi_at_buy_price(bet_on_yes, p, context.fee, context.fixed_cost, pi_bet).roi;
+    return true;
+}
+
+// Carnets par symbole de marché (jeton "Yes"), alimentés par le flux WebSocket ou par Rust
+class OrderBookStore {
+private:
+    mutable mutex books_mutex;
+    unordered_map<uint32_t, L2Book> books;
+    
+public:
+    // Modification sous verrou: fn(L2Book&)
+    template <typename Fn>
+    void update(uint32_t market, Fn&& fn) {
+        lock_guard<mutex> lock(books_mutex);
+        fn(books[market]);
+    }
+    
+    // Lecture sous verrou: fn(const L2Book&); false si aucun carnet
+    template <typename Fn>
+    bool read(uint32_t market, Fn&& fn) const {
+        lock_guard<mutex> lock(books_mutex);
+        auto it = books.find(market);
+        if (it == books.end()) return false;
+        fn(it->second);
+        return true;
+    }
+    
+    void erase(uint32_t market) {
+        lock_guard<mutex> lock(books_mutex);
+        books.erase(market);
+    }
+};
+
+OrderBookStore order_books;
+
+// Mise (en parts) utilisée pour le ROI au VWAP du carnet; 0 = modèle seul (sans carnet)
+std::atomic<double> depth_stake{0.0};
+
+// ROI d'un marché pour le pipeline: VWAP du carnet pour la mise configurée si possible, sinon modèle
+double market_roi(uint32_t market, double probability) {
+    RoiContext context = live_roi.load();
+    double stake = depth_stake.load(memory_order_relaxed);
+    double roi;
+    bool from_book = false;
+    if (stake > 0.0) {
+        order_books.read(market, [&](const L2Book& book) {
+            from_book = depth_roi(book, probability < 0.5, stake, context, roi);
+        });
+    }
+    return from_book ? roi : calculate_real_roi(context, probability);
+}
+
+// Construction de la table ROI pour la version de paramètres courante
+std::shared_ptr<const RoiTable> build_roi_table() {
+    auto table = std::make_shared<RoiTable>();
+    table->params_version = roi_params_version.load(std::memory_order_acquire);
+    RoiContext context = live_roi.load(); // lu après la version: au moins aussi récent
+    table->roi.resize(ROI_TABLE_TICKS + 1);
+    for (int i = 0; i <= ROI_TABLE_TICKS; i++) {
+        table->roi[i] = calculate_real_roi(context, (double)i / ROI_TABLE_TICKS);
+    }
+    table->yes_limit_at_half = calculate_real_roi(context, std::nextafter(0.5, 0.0));
+    return table;
+}
+
+// Reconstruction en arrière-plan: un thread dédié, réveillé à chaque changement de paramètres.
+// Les demandes arrivées pendant une construction sont regroupées en une seule reconstruction.
+class RoiTableBuilder {
+private:
+    std::mutex mtx;
+    std::condition_variable cv;
+    std::thread worker;
+    bool pending = false;
+    bool stopping = false;
+    
+    void run() {
+        std::unique_lock<std::mutex> lock(mtx);
+        while (true) {
+            cv.wait(lock, [this]() { return pending || stopping; });
+            if (stopping) return;
+            pending = false;
+            lock.unlock();
+            auto table = build_roi_table();
+            std::atomic_store(&precomputed_roi_table, table);
+            lock.lock();
+        }
+    }
+    
+public:
+    RoiTableBuilder() = default;
+    RoiTableBuilder(const RoiTableBuilder&) = delete;
+    RoiTableBuilder& operator=(const RoiTableBuilder&) = delete;
+    
+    ~RoiTableBuilder() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            stopping = true;
+        }
+        cv.notify_one();
+        if (worker.joinable()) worker.join();
+    }
+    
+    void request_rebuild() {
+        {
+            std::lock_guard<std::mutex> lock(mtx);
+            pending = true;
+            if (!worker.joinable()) worker = std::thread([this]() { run(); });
+        }
+        cv.notify_one();
+    }
+};
+
+RoiTableBuilder roi_table_builder;
+
+// ROI au contexte live via le cache (latence < 1μs)
+// Cache indexé par tick de prix (résolution 1/ROI_CACHE_TICKS): le ROI d'un tick est
+// celui de son prix quantifié. Lecture sans verrou, écriture réservée par CAS sur le slot.
+double cached_live_roi(double current_price) {
+    if (!(current_price >= 0.0 && current_price <= 1.0)) {
+        return calculate_real_roi(live_roi.load(), current_price);
+    }
+    
+    int tick = (int)std::lround(current_price * ROI_CACHE_TICKS);
+    RoiCacheSlot& slot = roi_cache[tick];
+    uint64_t version = roi_params_version.load(std::memory_order_acquire);
+    
+    uint64_t stamp = slot.stamp.load(std::memory_order_acquire);
+    if (stamp == version) {
+        double roi = slot.roi.load(std::memory_order_relaxed);
+        std::atomic_thread_fence(std::memory_order_acquire);
+        if (slot.stamp.load(std::memory_order_relaxed) == version) {
+            return roi; // Cache hit - retour immédiat
+        }
+    }
+    
+    // Cache miss - calcul au prix quantifié
+    double roi = calculate_real_roi(live_roi.load(), (double)tick / ROI_CACHE_TICKS);
+    
+    // Un seul écrivain par slot; si un autre thread écrit déjà, on ne met pas en cache
+    if ((stamp & ROI_SLOT_WRITING) == 0 &&
+        slot.stamp.compare_exchange_strong(stamp, version | ROI_SLOT_WRITING, std::memory_order_acquire)) {
+        slot.roi.store(roi, std::memory_order_relaxed);
+        slot.stamp.store(version, std::memory_order_release);
+    }
+    
+    return roi;
+}
+
+// ROI par interpolation linéaire entre deux ticks de la table.
+// Si la table manque ou date d'une autre version de paramètres, calcul direct via le cache.
+double lookup_roi_table(double price) {
+    auto table = std::atomic_load(&precomputed_roi_table);
+    if (!table || table->params_version != roi_params_version.load(std::memory_order_acquire) ||
+        !(price >= 0.0 && price <= 1.0)) {
+        return cached_live_roi(price);
+    }
+    
+    double x = price * ROI_TABLE_TICKS;
+    int i = (int)x;
+    if (i >= ROI_TABLE_TICKS) return table->roi[ROI_TABLE_TICKS];
+    
+    double frac = x - i;
+    double left = table->roi[i];
+    // Pas d'interpolation à travers le changement de côté du pari
+    double right = (price < 0.5 && i + 1 == ROI_TABLE_TICKS / 2) ? table->yes_limit_at_half : table->roi[i + 1];
+    return left + (right - left) * frac;
+}
+
+// ===== BALAYAGE PARALLÈLE DES PARAMÈTRES ROI =====
+// Répartition par vol de travail: chaque thread reçoit une plage contiguë de tâches, consommée
+// par l'avant; à court de travail, il vole la moitié arrière de la plus grande plage restante.
+// Les tâches sont indépendantes: le résultat ne dépend ni du nombre de threads ni des vols.
+class WorkStealingRanges {
+private:
+    struct alignas(64) Range {
+        std::mutex lock;
+        size_t begin = 0;
+        size_t end = 0;
+    };
+    
+    std::unique_ptr<Range[]> ranges;
+    size_t workers;
+    
+    bool steal(size_t thief, size_t& task) {
+        while (true) {
+            size_t victim = workers, largest = 0;
+            for (size_t w = 0; w < workers; w++) {
+                if (w == thief) continue;
+                std::lock_guard<std::mutex> lock(ranges[w].lock);
+                size_t left = ranges[w].end - ranges[w].begin;
+                if (left > largest) largest = left, victim = w;
+            }
+            if (victim == workers) return false; // plus rien nulle part: aucune tâche n'est créée en route
+            
+            size_t begin, end;
+            {
+                Range& r = ranges[victim];
+                std::lock_guard<std::mutex> lock(r.lock);
+                size_t left = r.end - r.begin;
+                if (left == 0) continue; // vidée entre-temps, chercher ailleurs
+                end = r.end;
+                begin = r.end - (left + 1) / 2;
+                r.end = begin;
+            }
+            std::lock_guard<std::mutex> lock(ranges[thief].lock);
+            ranges[thief].begin = begin + 1;
+            ranges[thief].end = end;
+            task = begin;
+            return true;
+        }
+    }
+    
+public:
+    WorkStealingRanges(size_t tasks, size_t worker_count) : ranges(new Range[worker_count]), workers(worker_count) {
+        for (size_t w = 0; w < workers; w++) {
+            ranges[w].begin = tasks * w / workers;
+            ranges[w].end = tasks * (w + 1) / workers;
+        }
+    }
+    
+    // Prochaine tâche du thread worker; false quand tout est consommé
+    bool next(size_t worker, size_t& task) {
+        {
+            Range& own = ranges[worker];
+            std::lock_guard<std::mutex> lock(own.lock);
+            if (own.begin < own.end) {
+                task = own.begin++;
+                return true;
+            }
+        }
+        return steal(worker, task);
+    }
+};
+
+// fn(task) pour task dans [0, tasks), sur threads threads (0: tous les cœurs) dont l'appelant
+template <typename Fn>
+void parallel_for_stealing(size_t tasks, size_t threads, Fn&& fn) {
+    if (threads == 0) threads = std::max(1u, std::thread::hardware_concurrency());
+    threads = std::max<size_t>(1, std::min(threads, tasks));
+    WorkStealingRanges ranges(tasks, threads);
+    auto worker = [&](size_t w) {
+        size_t task;
+        while (ranges.next(w, task)) fn(task);
+    };
+    std::vector<std::thread> pool;
+    for (size_t w = 1; w < threads; w++) pool.emplace_back(worker, w);
+    worker(0);
+    for (auto& t : pool) t.join();
+}
+
+// Surfaces d'un balayage, un point par contexte ROI. Seuls les marchés où la décision du
+// pipeline n'est pas MONITOR (ROI > 0.5%) sont des trades; outcome 1 = YES, 0 = NO, autre = non résolu.
+struct RoiSweepPoint {
+    double expected_roi = NAN;  // ROI modèle moyen des trades
+    double realized_roi = NAN;  // ROI moyen au dénouement des trades résolus
+    double hit_rate = NAN;      // part des trades résolus dont le côté parié a gagné
+    uint32_t trades = 0;
+    uint32_t resolved = 0;
+};
+
+const size_t ROI_SWEEP_BLOCK = 1024; // marchés par passe du noyau par lot (tient en L1)
+
+RoiSweepPoint roi_sweep_point(const RoiContext& context, const double* prices, const uint8_t* outcomes, size_t n) {
+    static const RoiBatchKernel kernel = select_roi_batch_kernel();
+    double roi[ROI_SWEEP_BLOCK];
+    uint8_t bet_yes[ROI_SWEEP_BLOCK];
+    double expected = 0.0, realized = 0.0;
+    uint32_t trades = 0, resolved = 0, wins = 0;
+    
+    for (size_t start = 0; start < n; start += ROI_SWEEP_BLOCK) {
+        size_t count = min(ROI_SWEEP_BLOCK, n - start);
+        kernel(context, prices + start, count, nullptr, nullptr, roi, bet_yes);
+        for (size_t i = 0; i < count; i++) {
+            if (decide_trade_action(roi[i] * 100) == TradeAction::MONITOR) continue;
+            trades++;
+            expected += roi[i];
+            uint8_t outcome = outcomes ? outcomes[start + i] : 2;
+            if (outcome > 1) continue;
+            
+            // Gain: (1-p)(1-f) - g, perte: -p - g, pour une mise p + g par part
+            RoiBreakdown r = context.breakdown(prices[start + i]);
+            bool won = (outcome == 1) == (bet_yes[i] != 0);
+            resolved++;
+            if (won) wins++;
+            realized += (won ? (1.0 - r.buy_price) * (1.0 - context.fee) - context.fixed_cost
+                             : -r.buy_price - context.fixed_cost) / (r.buy_price + context.fixed_cost);
+        }
+    }
+    
+    RoiSweepPoint point;
+    point.trades = trades;
+    point.resolved = resolved;
+    if (trades) point.expected_roi = expected / trades;
+    if (resolved) {
+        point.realized_roi = realized / resolved;
+        point.hit_rate = (double)wins / resolved;
+    }
+    return point;
+}
+
+// Un point par contexte de grid, répartis par vol de travail; ne lit ni n'écrit live_roi
+vector<RoiSweepPoint> sweep_roi_contexts(const vector<RoiContext>& grid, const double* prices,
+                                         const uint8_t* outcomes, size_t n, size_t threads) {
+    vector<RoiSweepPoint> points(grid.size());
+    parallel_for_stealing(grid.size(), threads, [&](size_t i) {
+        points[i] = roi_sweep_point(grid[i], prices, outcomes, n);
+    });
+    return points;
+}
+
+// ===== ARÈNE PAR CYCLE =====
+// Les conteneurs temporaires d'un cycle (marchés touchés, compteurs, listes de travail)
+// sont alloués par incrément de pointeur dans un tampon réutilisé, libéré d'un coup en
+// fin de cycle. Si un cycle déborde, le tampon est agrandi au pic observé: en régime
+// établi le chemin de décision n'appelle plus malloc.
+class CycleArena {
+private:
+    // Ressource amont qui compte les octets demandés au-delà du tampon
+    class OverflowResource : public std::pmr::memory_resource {
+    public:
+        size_t bytes = 0;
+        
+    private:
+        void* do_allocate(size_t n, size_t align) override {
+            bytes += n;
+            return std::pmr::new_delete_resource()->allocate(n, align);
+        }
+        void do_deallocate(void* p, size_t n, size_t align) override {
+            std::pmr::new_delete_resource()->deallocate(p, n, align);
+        }
+        bool do_is_equal(const std::pmr::memory_resource& other) const noexcept override {
+            return this == &other;
+        }
+    };
+    
+    size_t base_capacity;
+    size_t capacity = 0;
+    unique_ptr<std::byte[]> buffer;
+    OverflowResource overflow;
+    unique_ptr<std::pmr::monotonic_buffer_resource> resource;
+    
+    void reserve_buffer(size_t bytes) {
+        resource.reset();
+        buffer.reset(new std::byte[bytes]);
+        capacity = bytes;
+        resource = make_unique<std::pmr::monotonic_buffer_resource>(buffer.get(), capacity, &overflow);
+    }
+    
+public:
+    explicit CycleArena(size_t initial_bytes = 64 * 1024) : base_capacity(initial_bytes) {
+        reserve_buffer(base_capacity);
+    }
+    
+    std::pmr::memory_resource* get() { return resource.get(); }
+    
+    // Fin de cycle: tout ce qui a été alloué dans l'arène doit être détruit avant l'appel
+    void reset() {
+        size_t peak = capacity + overflow.bytes;
+        resource->release();
+        if (overflow.bytes > 0) reserve_buffer(peak);
+        overflow.bytes = 0;
+    }
+    
+    // Rend la mémoire d'un pic passé (taille initiale)
+    void trim() {
+        resource->release();
+        overflow.bytes = 0;
+        if (capacity > base_capacity) reserve_buffer(base_capacity);
+    }
+    
+    size_t capacity_bytes() const { return capacity; }
+};
+
+// Tampon sur la pile pour les appels ponctuels (détection, priorisation hors pipeline)
+template <size_t BYTES>
+class LocalArena {
+private:
+    alignas(std::max_align_t) std::byte buffer[BYTES];
+    std::pmr::monotonic_buffer_resource resource{buffer, BYTES};
+    
+public:
+    std::pmr::memory_resource* get() { return &resource; }
+};
+
+// Index inversé mot-clé de marché -> marchés, construit une fois par univers de marchés.
+// Un mot-clé trouvé dans une source "couvre" un mot-clé de marché s'il le contient;
+// cette relation est calculée une fois par mot-clé source distinct.
+class MarketKeywordIndex {
+private:
+    StringInterner market_keywords;                 // vocabulaire des mots-clés de marché
+    vector<vector<uint32_t>> keywords_by_market;    // marché -> ids de mots-clés
+    vector<vector<uint32_t>> markets_by_keyword;    // id de mot-clé -> marchés
+    mutable unordered_map<string, vector<uint32_t>> covered_by_found; // mot-clé source -> ids couverts
+    mutable mutex covered_mutex;
+    
+public:
+    MarketKeywordIndex() = default;
+    
+    explicit MarketKeywordIndex(const vector<Market>& markets) {
+        keywords_by_market.resize(markets.size());
+        auto taxonomy = current_taxonomy();
+        string domain;
+        vector<string> classified;
+        for (size_t m = 0; m < markets.size(); m++) {
+            // Mots-clés calculés à l'ingestion, sauf marché non classé ou taxonomie remplacée depuis
+            const vector<string>* keywords = &markets[m].keywords;
+            if (markets[m].taxonomy_version != taxonomy->version()) {
+                taxonomy->classify(markets[m].question, markets[m].description, domain, classified);
+                keywords = &classified;
+            }
+            for (const auto& keyword : *keywords) {
+                uint32_t id = market_keywords.intern(keyword);
+                if (id >= markets_by_keyword.size()) markets_by_keyword.resize(id + 1);
+                keywords_by_market[m].push_back(id);
+                markets_by_keyword[id].push_back((uint32_t)m);
+            }
+        }
+    }
+    
+    size_t market_count() const { return keywords_by_market.size(); }
+    const vector<uint32_t>& keywords_of(size_t market) const { return keywords_by_market[market]; }
+    const vector<uint32_t>& markets_with(uint32_t keyword) const { return markets_by_keyword[keyword]; }
+    const string& keyword_name(uint32_t keyword) const { return market_keywords.name(keyword); }
+    
+    // Ids des mots-clés de marché contenus dans un mot-clé trouvé sur une source
+    const vector<uint32_t>& covered_by(const string& found) const {
+        lock_guard<mutex> lock(covered_mutex);
+        auto it = covered_by_found.find(found);
+        if (it != covered_by_found.end()) return it->second;
+        
+        vector<uint32_t> covered;
+        for (uint32_t id = 0; id < market_keywords.size(); id++) {
+            if (found.find(market_keywords.name(id)) != string::npos) covered.push_back(id);
+        }
+        return covered_by_found.emplace(found, move(covered)).first->second;
+    }
+};
+
+shared_ptr<const MarketKeywordIndex> market_index; // protégé par update_mutex
+
+// Même univers de marchés (ids et textes identiques): l'index peut être conservé
+bool same_market_texts(const vector<Market>& a, const vector<Market>& b) {
+    if (a.size() != b.size()) return false;
+    for (size_t i = 0; i < a.size(); i++) {
+        if (a[i].id != b[i].id || a[i].question != b[i].question || a[i].description != b[i].description) return false;
+    }
+    return true;
+}
+
+// Couples (mot-clé marché, mot-clé source) correspondants, par marché touché par la source.
+// pair_count doit être nul à l'entrée pour tous les marchés; l'appelant le remet à zéro via touched.
+void count_source_keyword_pairs(const MarketKeywordIndex& index, const SourceData& source,
+                                std::pmr::vector<uint32_t>& pair_count, std::pmr::vector<uint32_t>& touched) {
+    for (const auto& found : source.found_keywords) {
+        for (uint32_t keyword : index.covered_by(found)) {
+            for (uint32_t m : index.markets_with(keyword)) {
+                if (pair_count[m]++ == 0) touched.push_back(m);
+            }
+        }
+    }
+}
+
+// Opportunité (market, source) pour un nombre de couples de mots-clés; false si hors seuil
+// Pertinence: 0.2 par couple, cumulée pas à pas comme la boucle d'origine (même arrondi)
+double keyword_relevance(uint32_t pairs) {
+    double relevance = 0.0;
+    for (uint32_t i = 0; i < pairs; i++) relevance += 0.2;
+    return relevance;
+}
+
+bool build_opportunity(const Market& market, const string& url, uint32_t pairs, ArbitrageOpportunity& opp) {
+    double relevance = keyword_relevance(pairs);
+    if (relevance <= 0.05) return false;
+    
+    opp.market_id = market.id;
+    opp.source_url = url;
+    opp.relevance_score = relevance;
+    opp.timestamp = chrono::system_clock::now();
+    opp.confidence = confidence_name(confidence_for_relevance(relevance));
+    
+    // ROI calculation with the live parameters
+    double new_roi = calculate_real_roi(live_roi.load(), market.probability);
+    
+    // Keep old calculations for compatibility
+    double difference = abs(0.5 - market.probability);
+    opp.potential_roi_v1 = difference * 100;
+    opp.potential_roi_v2 = new_roi * 100; // New ROI in percentage
+    
+    opp.reason = opportunity_reason(url, relevance);
+    return true;
+}
+
+// Arbitrage opportunity detection
+// Chaque source ne touche que les marchés dont un mot-clé est couvert par ses found_keywords.
+// Ordre de sortie: marchés dans l'ordre de markets, puis sources dans l'ordre des URLs.
+vector<ArbitrageOpportunity> detect_arbitrage_opportunities(const vector<Market>& markets, const map<string, SourceData>& sources,
+                                                            const MarketKeywordIndex& index) {
+    struct Hit {
+        uint32_t market;
+        uint32_t source;
+        uint32_t pairs;
+    };
+    
+    LocalArena<16 * 1024> arena;
+    vector<ArbitrageOpportunity> opportunities;
+    std::pmr::vector<Hit> hits(arena.get());
+    std::pmr::vector<const string*> source_order(arena.get());
+    std::pmr::vector<uint32_t> pair_count(index.market_count(), 0, arena.get());
+    std::pmr::vector<uint32_t> touched(arena.get());
+    
+    for (const auto& entry : sources) {
+        const SourceData& source = entry.second;
+        if (!source.accessible) continue;
+        
+        uint32_t source_idx = (uint32_t)source_order.size();
+        source_order.push_back(&entry.first);
+        
+        count_source_keyword_pairs(index, source, pair_count, touched);
+        for (uint32_t m : touched) {
+            hits.push_back({m, source_idx, pair_count[m]});
+            pair_count[m] = 0;
+        }
+        touched.clear();
+    }
+    
+    sort(hits.begin(), hits.end(), [](const Hit& a, const Hit& b) {
+        return a.market != b.market ? a.market < b.market : a.source < b.source;
+    });
+    
+    for (const auto& hit : hits) {
+        ArbitrageOpportunity opp;
+        if (build_opportunity(markets[hit.market], *source_order[hit.source], hit.pairs, opp)) {
+            opportunities.push_back(move(opp));
+        }
+    }
+    
+    return opportunities;
+}
+
+// Marchés touchés par une seule source (pipeline incrémental), en colonnes: indice de marché
+// dans l'univers de l'index et pertinence
+struct SourceHits {
+    vector<uint32_t> market_index;
+    vector<double> relevance;
+};
+
+// pair_count: compteurs nuls de taille index.market_count(), remis à zéro au retour
+SourceHits collect_source_hits(const MarketKeywordIndex& index, const SourceData& source,
+                               std::pmr::vector<uint32_t>& pair_count, std::pmr::memory_resource* scratch) {
+    SourceHits hits;
+    if (!source.accessible) return hits;
+    
+    std::pmr::vector<uint32_t> touched(scratch);
+    count_source_keyword_pairs(index, source, pair_count, touched);
+    sort(touched.begin(), touched.end());
+    
+    hits.market_index.reserve(touched.size());
+    hits.relevance.reserve(touched.size());
+    for (uint32_t m : touched) {
+        double relevance = keyword_relevance(pair_count[m]);
+        pair_count[m] = 0;
+        if (relevance <= 0.05) continue;
+        hits.market_index.push_back(m);
+        hits.relevance.push_back(relevance);
+    }
+    return hits;
+}
+
+// Sans index préconstruit (appels ponctuels): index temporaire
+vector<ArbitrageOpportunity> detect_arbitrage_opportunities(const vector<Market>& markets, const map<string, SourceData>& sources) {
+    MarketKeywordIndex index(markets);
+    return detect_arbitrage_opportunities(markets, sources, index);
+}
+
+// Nombre de trades retenus par la priorisation (0 = tous les marchés, comportement historique)
+atomic<size_t> trade_top_k{0};
+
+// Déduplication par marché: table à adressage ouvert (sondage linéaire) qui attribue
+// à chaque market_id distinct un identifiant dense, sans allocation par marché.
+class MarketIdTable {
+private:
+    std::pmr::vector<uint32_t> slots; // identifiant + 1, 0 = vide
+    std::pmr::vector<const string*> ids;
+    size_t mask = 0;
+    
+public:
+    MarketIdTable(size_t expected, std::pmr::memory_resource* memory) : slots(memory), ids(memory) {
+        size_t capacity = 16;
+        while (capacity < expected * 2) capacity <<= 1;
+        slots.assign(capacity, 0);
+        mask = capacity - 1;
+        ids.reserve(expected);
+    }
+    
+    // La chaîne doit rester valide pendant la durée de vie de la table
+    uint32_t intern(const string& market_id) {
+        size_t h = std::hash<string>()(market_id);
+        for (size_t i = h & mask;; i = (i + 1) & mask) {
+            uint32_t slot = slots[i];
+            if (slot == 0) {
+                uint32_t id = (uint32_t)ids.size();
+                slots[i] = id + 1;
+                ids.push_back(&market_id);
+                return id;
+            }
+            if (*ids[slot - 1] == market_id) return slot - 1;
+        }
+    }
+    
+    size_t size() const { return ids.size(); }
+};
+
+// Priorisation des trades par ROI - sélectionne toujours le ROI le plus élevé
+// et exécute automatiquement le meilleur trade avec 1€.
+// Un signal par marché (ROI v2 maximal, le premier en cas d'égalité); avec trade_top_k > 0,
+// seuls les K meilleurs marchés sont retenus via un tas borné.
+vector<TradingSignal> prioritize_trades_by_roi(const vector<TradingSignal>& signals) {
+    size_t top_k = trade_top_k.load(memory_order_relaxed);
+    
+    // Meilleur signal par marché
+    LocalArena<8 * 1024> arena;
+    MarketIdTable market_ids(signals.size(), arena.get());
+    std::pmr::vector<uint32_t> best_by_market(arena.get());
+    best_by_market.reserve(signals.size());
+    for (uint32_t i = 0; i < signals.size(); i++) {
+        uint32_t id = market_ids.intern(signals[i].market_id);
+        if (id == best_by_market.size()) best_by_market.push_back(i);
+        else if (signals[i].potential_roi_v2 > signals[best_by_market[id]].potential_roi_v2) best_by_market[id] = i;
+    }
+    
+    // ROI décroissant, ordre d'apparition en cas d'égalité
+    auto better = [&signals](uint32_t a, uint32_t b) {
+        double ra = signals[a].potential_roi_v2, rb = signals[b].potential_roi_v2;
+        return ra != rb ? ra > rb : a < b;
+    };
+    
+    std::pmr::vector<uint32_t> selected(arena.get());
+    if (top_k == 0 || top_k >= best_by_market.size()) {
+        selected = move(best_by_market);
+    } else {
+        // Tas borné: la racine est le pire des K retenus
+        selected.reserve(top_k);
+        for (uint32_t index : best_by_market) {
+            if (selected.size() < top_k) {
+                selected.push_back(index);
+                push_heap(selected.begin(), selected.end(), better);
+            } else if (better(index, selected.front())) {
+                pop_heap(selected.begin(), selected.end(), better);
+                selected.back() = index;
+                push_heap(selected.begin(), selected.end(), better);
+            }
+        }
+    }
+    sort(selected.begin(), selected.end(), better);
+    
+    vector<TradingSignal> unique_signals;
+    unique_signals.reserve(selected.size());
+    for (uint32_t index : selected) {
+        unique_signals.push_back(signals[index]);
+        PM_LOG(LogEvent::TRADE_PRIORITIZED, signals[index].market_id, signals[index].action, signals[index].potential_roi_v2);
+    }
+    
+    // EXÉCUTION AUTOMATIQUE du meilleur trade
+    if (!unique_signals.empty()) {
+        TradingSignal& best_trade = unique_signals[0];
+        if (best_trade.action != "MONITOR") {
+            PM_LOG(LogEvent::TRADE_EXECUTED, best_trade.market_id, best_trade.action, best_trade.potential_roi_v2);
+            
+            // Marquer comme exécuté
+            best_trade.action = "EXECUTED_" + string(best_trade.action);
+        }
+    }
+    
+    PM_LOG(LogEvent::PRIORITY_SUMMARY, unique_signals.size());
+    return unique_signals;
+}
+
+// Décision de trading pour une opportunité
+TradingSignal make_trading_signal(const ArbitrageOpportunity& opp) {
+    TradingSignal signal;
+    signal.market_id = opp.market_id;
+    signal.confidence = opp.confidence;
+    signal.potential_roi_v1 = opp.potential_roi_v1;
+    signal.potential_roi_v2 = opp.potential_roi_v2;
+    signal.source_url = opp.source_url;
+    signal.reason = opp.reason;
+    
+    TradeAction action = decide_trade_action(opp.potential_roi_v2);
+    signal.action = action_name(action);
+    if (action != TradeAction::MONITOR) PM_LOG(LogEvent::DECISION, opp.market_id, signal.action, opp.potential_roi_v2);
+    
+    // Réaction depuis la détection de l'opportunité, exécution estimée par la latence mesurée du CLOB
+    static const string clob_host = latency_host_key(POLYMARKET_API);
+    auto reaction = chrono::duration_cast<chrono::microseconds>(chrono::system_clock::now() - opp.timestamp);
+    signal.reaction_time = (uint64_t)max<int64_t>(0, reaction.count());
+    signal.execution_time = (uint64_t)(predicted_latency(clob_host) * 1e6);
+    signal.total_time = signal.reaction_time + signal.execution_time;
+    signal.grade = "B";
+    return signal;
+}
+
+// Trading signal generation avec priorisation par ROI
+// Priorité: ROI le plus élevé
+vector<TradingSignal> generate_trading_signals(const vector<ArbitrageOpportunity>& opportunities) {
+    vector<TradingSignal> signals;
+    
+    for (const auto& opp : opportunities) {
+        signals.push_back(make_trading_signal(opp));
+    }
+    
+    // Appliquer la priorisation par ROI pour éviter les conflits de timing
+    signals = prioritize_trades_by_roi(signals);
+    
+    return signals;
+}
+
+// ===== PIPELINE INCRÉMENTAL =====
+// Chaque source conserve ses propres marchés touchés; seule une source dont le contenu utile
+// (accessibilité, mots-clés trouvés) a changé est réévaluée. Le ROI est tenu par marché en
+// colonnes (il ne dépend que de la probabilité) et recalculé quand celle-ci change.
+// Le meilleur signal de chaque marché est maintenu dans un classement ordonné (ROI
+// décroissant); tout changement de meilleur signal produit un delta.
+// Recalcul complet seulement si l'univers de marchés ou les paramètres ROI changent.
+bool source_content_changed(const SourceData* previous, const SourceData& current) {
+    if (!previous) return true;
+    return previous->accessible != current.accessible || previous->found_keywords != current.found_keywords;
+}
+
+bool same_signal(const SignalRecord& a, const SignalRecord& b) {
+    return a.action == b.action && a.confidence == b.confidence && a.source == b.source &&
+           a.relevance == b.relevance && a.roi_v1 == b.roi_v1 && a.roi_v2 == b.roi_v2;
+}
+
+class IncrementalSignalPipeline {
+private:
+    // À ROI égal: ordre du marché dans l'univers (ordre du journal en rejeu), et non l'ordre
+    // d'internement des symboles, qui dépend de l'historique du processus
+    struct RankKey {
+        double roi;
+        uint32_t order;
+        uint32_t market;
+        bool operator<(const RankKey& other) const {
+            return roi != other.roi ? roi > other.roi : order < other.order;
+        }
+    };
+    
+    struct Candidate {
+        uint32_t source;
+        uint32_t market_index;
+        double relevance;
+    };
+    
+    shared_ptr<const MarketKeywordIndex> index;  // univers ayant produit l'état courant
+    uint32_t params_version = 0;
+    
+    // Pipeline de rejeu (detach): contexte ROI propre, ni logs ni statistiques globales
+    bool detached = false;
+    RoiContext own_context;
+    
+    // Univers de marchés en colonnes (indice = position dans markets)
+    vector<uint32_t> market_symbol;
+    vector<double> probability;
+    vector<double> roi_v1;
+    vector<double> roi_v2;
+    unordered_map<uint32_t, vector<uint32_t>> indices_by_symbol;
+    
+    unordered_map<uint32_t, SourceData> sources;       // dernier état utile par source
+    unordered_map<uint32_t, SourceHits> hits_by_source;
+    unordered_map<uint32_t, vector<Candidate>> candidates; // symbole de marché -> sources
+    unordered_map<uint32_t, SignalRecord> best;            // symbole de marché -> meilleur signal
+    set<RankKey> ranking;
+    unordered_map<uint32_t, RankKey> rank_keys;           // symbole de marché -> clé dans ranking
+    uint32_t executed_market = StringInterner::NONE;       // meilleur trade actuellement exécuté
+    SignalRecord executed_signal{};
+    
+    unordered_map<uint32_t, SignalRecord> cycle_deltas;   // changements du cycle, par marché
+    
+    // Instrumentation du cycle en cours (valide pendant apply/reprice)
+    StageTimes own_times;
+    StageTimes* cycle_times = &own_times;
+    uint64_t cycle_observed_ns = 0;
+    uint64_t cycle_execution_us = 0;
+    
+    size_t opportunity_count = 0;
+    size_t snapshot_top_k = 0;
+    
+    using IdSet = std::pmr::unordered_set<uint32_t>;
+    CycleArena arena;                          // temporaires d'un appel à apply()
+    std::pmr::vector<uint32_t> pair_count;     // par indice de marché, toujours nul entre deux sources
+    
+    void price_market(size_t m) {
+        double roi = detached ? own_context.roi(probability[m]) : market_roi(market_symbol[m], probability[m]);
+        roi_v1[m] = abs(0.5 - probability[m]) * 100;
+        roi_v2[m] = roi * 100; // New ROI in percentage
+    }
+    
+    void load_markets(const vector<Market>& markets, const vector<double>* prices) {
+        size_t n = markets.size();
+        market_symbol.resize(n);
+        pair_count.assign(n, 0);
+        probability.resize(n);
+        roi_v1.resize(n);
+        roi_v2.resize(n);
+        indices_by_symbol.clear();
+        for (size_t m = 0; m < n; m++) {
+            market_symbol[m] = market_symbols.intern(markets[m].id);
+            indices_by_symbol[market_symbol[m]].push_back((uint32_t)m);
+            probability[m] = prices ? (*prices)[m] : markets[m].probability;
+            price_market(m);
+        }
+    }
+    
+    void remove_source(uint32_t source, IdSet& touched_markets) {
+        auto it = hits_by_source.find(source);
+        if (it == hits_by_source.end()) return;
+        for (uint32_t m : it->second.market_index) {
+            uint32_t symbol = market_symbol[m];
+            auto c = candidates.find(symbol);
+            if (c != candidates.end()) {
+                auto& list = c->second;
+                list.erase(remove_if(list.begin(), list.end(), [&](const Candidate& x) {
+                    return x.source == source && x.market_index == m;
+                }), list.end());
+                if (list.empty()) candidates.erase(c);
+            }
+            touched_markets.insert(symbol);
+        }
+        opportunity_count -= it->second.market_index.size();
+        hits_by_source.erase(it);
+    }
+    
+    void add_source(uint32_t source, const SourceData& data, IdSet& touched_markets) {
+        SourceHits hits = collect_source_hits(*index, data, pair_count, arena.get());
+        if (hits.market_index.empty()) return;
+        for (size_t i = 0; i < hits.market_index.size(); i++) {
+            uint32_t m = hits.market_index[i];
+            candidates[market_symbol[m]].push_back({source, m, hits.relevance[i]});
+            touched_markets.insert(market_symbol[m]);
+        }
+        opportunity_count += hits.market_index.size();
+        hits_by_source[source] = move(hits);
+    }
+    
+    void rank(uint32_t symbol, double roi) {
+        auto it = indices_by_symbol.find(symbol);
+        RankKey key{roi, it == indices_by_symbol.end() ? UINT32_MAX : it->second.front(), symbol};
+        ranking.insert(key);
+        rank_keys[symbol] = key;
+    }
+    
+    void unrank(uint32_t symbol) {
+        auto it = rank_keys.find(symbol);
+        if (it == rank_keys.end()) return;
+        ranking.erase(it->second);
+        rank_keys.erase(it);
+    }
+    
+    void emit_delta(const SignalRecord& record) {
+        cycle_deltas[record.market] = record;
+    }
+    
+    void begin_cycle(StageTimes* times, uint64_t observed_ns) {
+        static const string clob_host = latency_host_key(POLYMARKET_API);
+        own_times = StageTimes{};
+        cycle_times = times ? times : &own_times;
+        cycle_observed_ns = observed_ns ? observed_ns : pipeline_clock_ns();
+        cycle_execution_us = (uint64_t)(predicted_latency(clob_host) * 1e6);
+    }
+    
+    // Meilleur candidat d'un marché: ROI v2 maximal, premier URL en cas d'égalité
+    void refresh_market(uint32_t symbol) {
+        uint64_t start_ns = pipeline_clock_ns();
+        auto old_best = best.find(symbol);
+        auto c = candidates.find(symbol);
+        
+        if (c == candidates.end()) {
+            if (old_best != best.end()) {
+                unrank(symbol);
+                SignalRecord cleared = old_best->second;
+                cleared.action = TradeAction::CLEAR;
+                cleared.executed = false;
+                cleared.observed_ns = cycle_observed_ns;
+                emit_delta(cleared);
+                best.erase(old_best);
+            }
+            cycle_times->lap(PipelineStage::DETECT, start_ns);
+            return;
+        }
+        
+        const Candidate* winner = nullptr;
+        for (const auto& candidate : c->second) {
+            if (!winner || roi_v2[candidate.market_index] > roi_v2[winner->market_index] ||
+                (roi_v2[candidate.market_index] == roi_v2[winner->market_index] &&
+                 source_symbols.name(candidate.source) < source_symbols.name(winner->source))) {
+                winner = &candidate;
+            }
+        }
+        
+        uint64_t decide_ns = cycle_times->lap(PipelineStage::DETECT, start_ns);
+        SignalRecord record{};
+        record.market = symbol;
+        record.source = winner->source;
+        record.relevance = winner->relevance;
+        record.confidence = confidence_for_relevance(winner->relevance);
+        record.roi_v1 = roi_v1[winner->market_index];
+        record.roi_v2 = roi_v2[winner->market_index];
+        record.action = decide_trade_action(record.roi_v2);
+        record.grade = SignalGrade::B;
+        uint64_t decided_ns = pipeline_clock_ns();
+        record.observed_ns = cycle_observed_ns;
+        record.reaction_time = (decided_ns - cycle_observed_ns) / 1000;
+        record.execution_time = cycle_execution_us;
+        record.total_time = record.reaction_time + record.execution_time;
+        
+        if (old_best != best.end()) {
+            if (same_signal(old_best->second, record)) {
+                cycle_times->lap(PipelineStage::DECIDE, decide_ns);
+                return;
+            }
+            unrank(symbol);
+        }
+        best[symbol] = record;
+        rank(symbol, record.roi_v2);
+        emit_delta(record);
+        if (!detached) {
+            pipeline_stats.reaction.record_value(decided_ns - cycle_observed_ns);
+            if (record.action != TradeAction::MONITOR) {
+                PM_LOG(LogEvent::DECISION, market_symbols.name(symbol), action_name(record.action), record.roi_v2);
+            }
+            PM_LOG(LogEvent::TRADE_PRIORITIZED, market_symbols.name(symbol), action_name(record.action), record.roi_v2);
+        }
+        cycle_times->lap(PipelineStage::DECIDE, decide_ns);
+    }
+    
+    // Le trade exécuté redevient un signal ordinaire (delta sans préfixe EXECUTED_)
+    void release_execution() {
+        if (executed_market == StringInterner::NONE) return;
+        auto previous = best.find(executed_market);
+        if (previous != best.end()) {
+            SignalRecord released = previous->second;
+            released.observed_ns = cycle_observed_ns;
+            emit_delta(released);
+        }
+        executed_market = StringInterner::NONE;
+    }
+    
+    // EXÉCUTION AUTOMATIQUE du meilleur trade, une fois par changement du meilleur signal
+    void refresh_execution() {
+        uint64_t start_ns = pipeline_clock_ns();
+        update_execution();
+        cycle_times->lap(PipelineStage::DECIDE, start_ns);
+    }
+    
+    void update_execution() {
+        if (ranking.empty() || best[ranking.begin()->market].action == TradeAction::MONITOR) {
+            release_execution();
+            return;
+        }
+        const SignalRecord& top = best[ranking.begin()->market];
+        if (executed_market == top.market && same_signal(executed_signal, top)) return;
+        
+        if (!detached) PM_LOG(LogEvent::TRADE_EXECUTED, market_symbols.name(top.market), action_name(top.action), top.roi_v2);
+        if (executed_market != top.market) release_execution();
+        executed_market = top.market;
+        executed_signal = top;
+        SignalRecord executed = top;
+        executed.executed = true;
+        executed.observed_ns = cycle_observed_ns;
+        emit_delta(executed);
+    }
+    
+public:
+    // Rejeu: ROI au modèle avec un contexte fixe (sans carnet ni live_roi), sans journalisation
+    // ni statistiques globales; plusieurs pipelines détachés peuvent tourner en parallèle
+    void detach(const RoiContext& context) {
+        detached = true;
+        own_context = context;
+    }
+    
+    // Applique un nouveau cycle; renvoie le nombre de marchés réévalués (0: état inchangé)
+    // prices (optionnel): probabilité effective par marché (prix temps réel), sinon markets[m].probability
+    // times (optionnel): reçoit le temps des étapes MATCH à DECIDE; observed_ns: instant d'observation
+    // des données du cycle (0: maintenant)
+    size_t apply(const vector<Market>& markets, shared_ptr<const MarketKeywordIndex> current_index,
+                 const map<string, SourceData>& current_sources, const vector<double>* prices = nullptr,
+                 StageTimes* times = nullptr, uint64_t observed_ns = 0) {
+        begin_cycle(times, observed_ns);
+        size_t changed = apply_cycle(markets, move(current_index), current_sources, prices);
+        arena.reset();
+        return changed;
+    }
+    
+    // Prix temps réel (flux WebSocket): seuls les marchés concernés sont re-pricés et réévalués
+    // Avec une mise au VWAP (depth_stake > 0), la profondeur compte: re-pricé même à milieu inchangé
+    size_t reprice(const unordered_map<uint32_t, double>& new_prices, StageTimes* times = nullptr,
+                   uint64_t observed_ns = 0) {
+        begin_cycle(times, observed_ns);
+        bool by_depth = !detached && depth_stake.load(memory_order_relaxed) > 0.0;
+        size_t changed = 0;
+        for (const auto& entry : new_prices) {
+            auto it = indices_by_symbol.find(entry.first);
+            if (it == indices_by_symbol.end()) continue;
+            uint64_t price_ns = pipeline_clock_ns();
+            bool moved = false;
+            for (uint32_t m : it->second) {
+                bool price_moved = probability[m] != entry.second;
+                if (!price_moved && !by_depth) continue;
+                double previous_roi = roi_v2[m];
+                probability[m] = entry.second;
+                price_market(m);
+                moved = moved || price_moved || roi_v2[m] != previous_roi;
+            }
+            cycle_times->lap(PipelineStage::PRICE, price_ns);
+            if (!moved) continue;
+            refresh_market(entry.first);
+            changed++;
+        }
+        if (changed > 0) refresh_execution();
+        return changed;
+    }
+    
+    // Probabilité effective par indice de marché (dernier prix connu)
+    const vector<double>& prices() const { return probability; }
+    
+    // Symbole du trade actuellement exécuté (StringInterner::NONE: aucun)
+    uint32_t executed() const { return executed_market; }
+    
+    // Rend la mémoire de l'arène après un pic (cleanup_hft_cache)
+    void trim_arena() { arena.trim(); }
+    
+private:
+    size_t apply_cycle(const vector<Market>& markets, shared_ptr<const MarketKeywordIndex> current_index,
+                       const map<string, SourceData>& current_sources, const vector<double>* prices) {
+        uint32_t version = detached ? params_version : roi_params_version.load(memory_order_acquire);
+        bool full = current_index != index || version != params_version;
+        index = move(current_index);
+        params_version = version;
+        
+        IdSet touched_markets(arena.get());
+        uint64_t stage_ns = pipeline_clock_ns();
+        
+        if (full) {
+            for (const auto& entry : best) touched_markets.insert(entry.first);
+            sources.clear();
+            hits_by_source.clear();
+            candidates.clear();
+            opportunity_count = 0;
+            load_markets(markets, prices);
+            // Ordre de départage du nouvel univers pour les signaux conservés
+            ranking.clear();
+            rank_keys.clear();
+            for (const auto& entry : best) rank(entry.first, entry.second.roi_v2);
+        } else {
+            // Même univers: seuls les marchés dont la probabilité a bougé sont re-pricés
+            for (size_t m = 0; m < markets.size(); m++) {
+                double p = prices ? (*prices)[m] : markets[m].probability;
+                if (p == probability[m]) continue;
+                probability[m] = p;
+                price_market(m);
+                touched_markets.insert(market_symbol[m]);
+            }
+        }
+        stage_ns = cycle_times->lap(PipelineStage::PRICE, stage_ns);
+        
+        IdSet current_ids(arena.get()); // sources de ce cycle
+        for (const auto& entry : current_sources) {
+            uint32_t source = source_symbols.intern(entry.first);
+            current_ids.insert(source);
+            auto previous = sources.find(source);
+            if (previous != sources.end() && !source_content_changed(&previous->second, entry.second)) continue;
+            if (previous != sources.end()) remove_source(source, touched_markets);
+            add_source(source, entry.second, touched_markets);
+            sources[source] = entry.second;
+        }
+        for (auto it = sources.begin(); it != sources.end();) {
+            if (current_ids.count(it->first)) {
+                ++it;
+                continue;
+            }
+            remove_source(it->first, touched_markets);
+            it = sources.erase(it);
+        }
+        cycle_times->lap(PipelineStage::MATCH, stage_ns);
+        
+        for (uint32_t symbol : touched_markets) refresh_market(symbol);
+        refresh_execution();
+        
+        if (!touched_markets.empty() && !detached) PM_LOG(LogEvent::PRIORITY_SUMMARY, best.size());
+        return touched_markets.size();
+    }
+    
+public:
+    
+    // Signaux priorisés (un par marché, ROI décroissant), équivalent à prioritize_trades_by_roi
+    vector<SignalRecord> snapshot() {
+        size_t top_k = trade_top_k.load(memory_order_relaxed);
+        snapshot_top_k = top_k;
+        size_t count = top_k == 0 ? ranking.size() : min(top_k, ranking.size());
+        vector<SignalRecord> out;
+        out.reserve(count);
+        for (const auto& key : ranking) {
+            if (out.size() == count) break;
+            out.push_back(best.at(key.market));
+            out.back().executed = key.market == executed_market;
+        }
+        return out;
+    }
+    
+    // Marchés touchés par une source et ROI v2 positif cumulé (planification des sources)
+    pair<size_t, double> source_demand(uint32_t source) const {
+        auto it = hits_by_source.find(source);
+        if (it == hits_by_source.end()) return {0, 0.0};
+        double roi = 0.0;
+        for (uint32_t m : it->second.market_index) roi += max(0.0, roi_v2[m]);
+        return {it->second.market_index.size(), roi};
+    }
+    
+    // Meilleur ROI v2 d'un marché (0 si absent de l'univers)
+    double market_roi_v2(uint32_t symbol) const {
+        auto it = indices_by_symbol.find(symbol);
+        if (it == indices_by_symbol.end()) return 0.0;
+        double roi = 0.0;
+        for (uint32_t m : it->second) roi = max(roi, roi_v2[m]);
+        return roi;
+    }
+    
+    OpportunityColumns opportunities() const {
+        OpportunityColumns out;
+        for (const auto& entry : hits_by_source) {
+            const SourceHits& hits = entry.second;
+            for (size_t i = 0; i < hits.market_index.size(); i++) {
+                uint32_t m = hits.market_index[i];
+                out.push(market_symbol[m], entry.first, hits.relevance[i], roi_v1[m], roi_v2[m]);
+            }
+        }
+        return out;
+    }
+    
+    bool snapshot_stale() const { return snapshot_top_k != trade_top_k.load(memory_order_relaxed); }
+    
+    // Deltas produits depuis le dernier appel (à transmettre à la file de deltas)
+    unordered_map<uint32_t, SignalRecord> take_cycle_deltas() {
+        unordered_map<uint32_t, SignalRecord> out;
+        out.swap(cycle_deltas);
+        return out;
+    }
+};
+
+// File des deltas de signaux en attente de lecture par Rust, coalescés par marché.
+// Verrou propre: la lecture des deltas ne bloque pas un cycle en cours.
+class SignalDeltaQueue {
+private:
+    unordered_map<uint32_t, SignalRecord> pending;
+    vector<TradingSignal> delivered; // chaînes exposées au dernier drain
+    mutable mutex queue_mutex;
+    
+public:
+    void push(unordered_map<uint32_t, SignalRecord>&& deltas) {
+        if (deltas.empty()) return;
+        lock_guard<mutex> lock(queue_mutex);
+        if (pending.empty()) {
+            pending.swap(deltas);
+            return;
+        }
+        for (auto& entry : deltas) pending[entry.first] = entry.second;
+    }
+    
+    size_t size() const {
+        lock_guard<mutex> lock(queue_mutex);
+        return pending.size();
+    }
+    
+    // Transfère au plus cap deltas; les chaînes restent valides jusqu'au prochain appel
+    size_t drain(TradingSignal_C* out, size_t cap) {
+        lock_guard<mutex> lock(queue_mutex);
+        delivered.clear();
+        auto it = pending.begin();
+        while (it != pending.end() && delivered.size() < cap) {
+            delivered.push_back(materialize_signal(it->second));
+            it = pending.erase(it);
+        }
+        for (size_t i = 0; i < delivered.size(); i++) {
+            const TradingSignal& s = delivered[i];
+            out[i].market_id = const_cast<char*>(s.market_id.c_str());
+            out[i].action = const_cast<char*>(s.action.c_str());
+            out[i].confidence = const_cast<char*>(s.confidence.c_str());
+            out[i].potential_roi_v1 = s.potential_roi_v1;
+            out[i].potential_roi_v2 = s.potential_roi_v2;
+            out[i].source_url = const_cast<char*>(s.source_url.c_str());
+            out[i].reason = const_cast<char*>(s.reason.c_str());
+            out[i].reaction_time = s.reaction_time;
+            out[i].execution_time = s.execution_time;
+            out[i].total_time = s.total_time;
+            out[i].grade = const_cast<char*>(s.grade.c_str());
+        }
+        return delivered.size();
+    }
+};
+
+IncrementalSignalPipeline signal_pipeline; // protégé par update_mutex
+SignalDeltaQueue signal_deltas;
+
+// ===== HISTORIQUE SQLITE =====
+// Ticks de prix, états des sources, signaux émis et textes des marchés (rejeu), persistés par un thread d'écriture:
+// les producteurs (cycle, flux temps réel) ne font qu'empiler sous un verrou court, jamais d'E/S.
+// WAL + synchronous=NORMAL, requêtes préparées une fois, une transaction par lot.
+// Une connexion de lecture séparée sert les requêtes par plage de temps (index (clé, ts)).
+const size_t HISTORY_BATCH_ROWS = 1024;
+const size_t HISTORY_MAX_PENDING = 200000; // au-delà, les lignes sont perdues (comptées)
+const int HISTORY_FLUSH_MS = 250;
+
+const char* HISTORY_SCHEMA =
+    "CREATE TABLE IF NOT EXISTS ticks ("
+    "  market TEXT NOT NULL, ts INTEGER NOT NULL, price REAL NOT NULL, origin INTEGER NOT NULL);"
+    "CREATE INDEX IF NOT EXISTS ticks_market_ts ON ticks(market, ts);"
+    "CREATE TABLE IF NOT EXISTS source_snapshots ("
+    "  url TEXT NOT NULL, ts INTEGER NOT NULL, accessible INTEGER NOT NULL, content_length INTEGER,"
+    "  keywords TEXT, error TEXT, etag TEXT, last_modified TEXT, content_hash INTEGER,"
+    "  keyword_signature INTEGER, truncated INTEGER);"
+    "CREATE INDEX IF NOT EXISTS source_snapshots_url_ts ON source_snapshots(url, ts);"
+    "CREATE TABLE IF NOT EXISTS signals ("
+    "  market TEXT NOT NULL, ts INTEGER NOT NULL, source TEXT, action TEXT, confidence TEXT,"
+    "  relevance REAL, roi_v1 REAL, roi_v2 REAL);"
+    "CREATE INDEX IF NOT EXISTS signals_market_ts ON signals(market, ts);"
+    "CREATE TABLE IF NOT EXISTS markets ("
+    "  id TEXT PRIMARY KEY, ts INTEGER NOT NULL, question TEXT, description TEXT, probability REAL);";
+
+enum class TickOrigin : uint8_t { REST = 0, FEED = 1 };
+
+int64_t history_now_ms() {
+    return chrono::duration_cast<chrono::milliseconds>(chrono::system_clock::now().time_since_epoch()).count();
+}
+
+// Requête préparée, finalisée à la destruction
+class SqliteStatement {
+private:
+    sqlite3_stmt* stmt = nullptr;
+    
+public:
+    SqliteStatement() = default;
+    SqliteStatement(const SqliteStatement&) = delete;
+    SqliteStatement& operator=(const SqliteStatement&) = delete;
+    ~SqliteStatement() { reset_handle(); }
+    
+    bool prepare(sqlite3* db, const char* sql) {
+        reset_handle();
+        return sqlite3_prepare_v2(db, sql, -1, &stmt, nullptr) == SQLITE_OK;
+    }
+    
+    void reset_handle() {
+        if (stmt) sqlite3_finalize(stmt);
+        stmt = nullptr;
+    }
+    
+    sqlite3_stmt* get() const { return stmt; }
+    
+    void bind(int i, int64_t value) { sqlite3_bind_int64(stmt, i, value); }
+    void bind(int i, double value) { sqlite3_bind_double(stmt, i, value); }
+    void bind(int i, const string& value) { sqlite3_bind_text(stmt, i, value.data(), (int)value.size(), SQLITE_STATIC); }
+    void bind(int i, const char* value) { sqlite3_bind_text(stmt, i, value, -1, SQLITE_STATIC); }
+    
+    // Exécute une requête sans résultat puis la réarme
+    bool run() {
+        int rc = sqlite3_step(stmt);
+        sqlite3_reset(stmt);
+        sqlite3_clear_bindings(stmt);
+        return rc == SQLITE_DONE;
+    }
+};
+
+class HistoryStore {
+private:
+    struct TickRow {
+        uint32_t market;
+        int64_t ts;
+        double price;
+        TickOrigin origin;
+    };
+    
+    struct SourceRow {
+        int64_t ts;
+        SourceData data;
+    };
+    
+    struct SignalRow {
+        int64_t ts;
+        SignalRecord record;
+    };
+    
+    struct MarketRow {
+        int64_t ts;
+        string id;
+        string question;
+        string description;
+        double probability;
+    };
+    
+    // Lignes en attente (producteurs -> thread d'écriture)
+    mutex queue_mutex;
+    condition_variable queue_ready;
+    vector<TickRow> pending_ticks;
+    vector<SourceRow> pending_sources;
+    vector<SignalRow> pending_signals;
+    vector<MarketRow> pending_markets;
+    unordered_map<uint32_t, double> last_tick; // dernier prix mis en file par marché
+    bool stopping = false;
+    bool flush_requested = false;
+    uint64_t flush_generation = 0;   // demandes de flush()
+    uint64_t flushed_generation = 0; // dernière demande servie
+    condition_variable flushed;
+    atomic<bool> opened{false};      // lu sans verrou par les producteurs
+    
+    sqlite3* writer_db = nullptr; // thread d'écriture uniquement (après open)
+    SqliteStatement insert_tick, insert_source, insert_signal, insert_market, begin_batch, commit_batch;
+    
+    mutex reader_mutex;
+    sqlite3* reader_db = nullptr;
+    SqliteStatement select_ticks;
+    
+    thread worker;
+    
+    size_t pending_rows() const {
+        return pending_ticks.size() + pending_sources.size() + pending_signals.size() + pending_markets.size();
+    }
+    
+    // File pleine: la ligne est perdue et comptée; les appelants continuent leur boucle pour que
+    // chaque ligne refusée du lot soit comptée (la file ne se vide pas sous queue_mutex)
+    bool admit() {
+        if (pending_rows() < HISTORY_MAX_PENDING) return true;
+        dropped.fetch_add(1, memory_order_relaxed);
+        return false;
+    }
+    
+    // Ticks (symbole, prix); seuls les prix différents du dernier mis en file sont retenus
+    template <typename It>
+    void enqueue_ticks(It begin, It end, TickOrigin origin) {
+        int64_t ts = history_now_ms();
+        lock_guard<mutex> lock(queue_mutex);
+        for (It it = begin; it != end; ++it) {
+            auto last = last_tick.find(it->first);
+            if (last != last_tick.end() && last->second == it->second) continue;
+            if (!admit()) continue;
+            if (last != last_tick.end()) last->second = it->second;
+            else last_tick.emplace(it->first, it->second);
+            pending_ticks.push_back({it->first, ts, it->second, origin});
+        }
+        if (pending_rows() >= HISTORY_BATCH_ROWS) queue_ready.notify_one();
+    }
+    
+    // Noms des symboles côté écriture (une résolution par symbole)
+    vector<string> writer_names;
+    const string& writer_name(uint32_t market) {
+        if (market >= writer_names.size()) writer_names.resize(market + 1);
+        if (writer_names[market].empty()) writer_names[market] = market_symbols.name(market);
+        return writer_names[market];
+    }
+    
+    static sqlite3* open_connection(const string& path, string& error) {
+        sqlite3* db = nullptr;
+        int rc = sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READWRITE | SQLITE_OPEN_CREATE | SQLITE_OPEN_NOMUTEX, nullptr);
+        if (rc != SQLITE_OK) {
+            error = db ? sqlite3_errmsg(db) : sqlite3_errstr(rc);
+            if (db) sqlite3_close(db);
+            return nullptr;
+        }
+        sqlite3_busy_timeout(db, 2000);
+        sqlite3_exec(db, "PRAGMA journal_mode=WAL; PRAGMA synchronous=NORMAL; PRAGMA temp_store=MEMORY;",
+                     nullptr, nullptr, nullptr);
+        return db;
+    }
+    
+    void write_batch(vector<TickRow>& ticks, vector<SourceRow>& sources, vector<SignalRow>& signals,
+                     vector<MarketRow>& markets) {
+        auto start_time = chrono::steady_clock::now();
+        begin_batch.run();
+        for (const auto& row : ticks) {
+            insert_tick.bind(1, writer_name(row.market));
+            insert_tick.bind(2, row.ts);
+            insert_tick.bind(3, row.price);
+            insert_tick.bind(4, (int64_t)row.origin);
+            insert_tick.run();
+        }
+        for (const auto& row : sources) {
+            const SourceData& data = row.data;
+            string keywords;
+            for (const auto& keyword : data.found_keywords) {
+                if (!keywords.empty()) keywords += '\n';
+                keywords += keyword;
+            }
+            insert_source.bind(1, data.url);
+            insert_source.bind(2, row.ts);
+            insert_source.bind(3, (int64_t)data.accessible);
+            insert_source.bind(4, (int64_t)data.content_length);
+            insert_source.bind(5, keywords);
+            insert_source.bind(6, data.error);
+            insert_source.bind(7, data.etag);
+            insert_source.bind(8, data.last_modified);
+            insert_source.bind(9, (int64_t)data.content_hash);
+            insert_source.bind(10, (int64_t)data.keyword_signature);
+            insert_source.bind(11, (int64_t)data.truncated);
+            insert_source.run();
+        }
+        for (const auto& row : signals) {
+            const SignalRecord& r = row.record;
+            insert_signal.bind(1, writer_name(r.market));
+            insert_signal.bind(2, row.ts);
+            insert_signal.bind(3, source_symbols.name(r.source));
+            insert_signal.bind(4, action_name(r.action, r.executed));
+            insert_signal.bind(5, confidence_name(r.confidence));
+            insert_signal.bind(6, r.relevance);
+            insert_signal.bind(7, r.roi_v1);
+            insert_signal.bind(8, r.roi_v2);
+            insert_signal.run();
+        }
+        for (const auto& row : markets) {
+            insert_market.bind(1, row.id);
+            insert_market.bind(2, row.ts);
+            insert_market.bind(3, row.question);
+            insert_market.bind(4, row.description);
+            insert_market.bind(5, row.probability);
+            insert_market.run();
+        }
+        size_t rows = ticks.size() + sources.size() + signals.size() + markets.size();
+        if (commit_batch.run()) {
+            written.fetch_add(rows, memory_order_relaxed);
+            PM_LOG(LogEvent::HISTORY_FLUSHED, rows,
+                   chrono::duration_cast<chrono::microseconds>(chrono::steady_clock::now() - start_time).count());
+        } else {
+            PM_LOG(LogEvent::HISTORY_ERROR, "commit", sqlite3_errmsg(writer_db));
+            sqlite3_exec(writer_db, "ROLLBACK", nullptr, nullptr, nullptr);
+            dropped.fetch_add(rows, memory_order_relaxed);
+        }
+        ticks.clear();
+        sources.clear();
+        signals.clear();
+        markets.clear();
+    }
+    
+    void run() {
+        vector<TickRow> ticks;
+        vector<SourceRow> sources;
+        vector<SignalRow> signals;
+        vector<MarketRow> markets;
+        while (true) {
+            uint64_t generation;
+            bool done;
+            {
+                unique_lock<mutex> lock(queue_mutex);
+                queue_ready.wait_for(lock, chrono::milliseconds(HISTORY_FLUSH_MS), [&] {
+                    return stopping || flush_requested || pending_rows() >= HISTORY_BATCH_ROWS;
+                });
+                ticks.swap(pending_ticks);
+                sources.swap(pending_sources);
+                signals.swap(pending_signals);
+                markets.swap(pending_markets);
+                flush_requested = false;
+                generation = flush_generation;
+                done = stopping;
+            }
+            if (!ticks.empty() || !sources.empty() || !signals.empty() || !markets.empty()) {
+                write_batch(ticks, sources, signals, markets);
+            }
+            {
+                lock_guard<mutex> lock(queue_mutex);
+                flushed_generation = generation;
+            }
+            flushed.notify_all();
+            if (done) break;
+        }
+    }
+    
+public:
+    atomic<uint64_t> written{0};
+    atomic<uint64_t> dropped{0};
+    
+    ~HistoryStore() { close(); }
+    
+    bool is_open() const { return opened.load(memory_order_acquire); }
+    
+    bool open(const string& path) {
+        close();
+        string error;
+        writer_db = open_connection(path, error);
+        if (writer_db) {
+            char* message = nullptr;
+            if (sqlite3_exec(writer_db, HISTORY_SCHEMA, nullptr, nullptr, &message) != SQLITE_OK) {
+                error = message ? message : "schema";
+                sqlite3_free(message);
+            }
+        }
+        if (error.empty()) reader_db = open_connection(path, error);
+        
+        bool prepared = error.empty() &&
+            insert_tick.prepare(writer_db, "INSERT INTO ticks(market, ts, price, origin) VALUES(?1, ?2, ?3, ?4)") &&
+            insert_source.prepare(writer_db,
+                "INSERT INTO source_snapshots(url, ts, accessible, content_length, keywords, error, etag, last_modified,"
+                " content_hash, keyword_signature, truncated) VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8, ?9, ?10, ?11)") &&
+            insert_signal.prepare(writer_db,
+                "INSERT INTO signals(market, ts, source, action, confidence, relevance, roi_v1, roi_v2)"
+                " VALUES(?1, ?2, ?3, ?4, ?5, ?6, ?7, ?8)") &&
+            insert_market.prepare(writer_db,
+                "INSERT OR REPLACE INTO markets(id, ts, question, description, probability) VALUES(?1, ?2, ?3, ?4, ?5)") &&
+            begin_batch.prepare(writer_db, "BEGIN") &&
+            commit_batch.prepare(writer_db, "COMMIT") &&
+            select_ticks.prepare(reader_db,
+                "SELECT ts, price FROM ticks WHERE market = ?1 AND ts >= ?2 AND ts <= ?3 ORDER BY ts DESC LIMIT ?4");
+        if (!prepared) {
+            if (error.empty()) error = sqlite3_errmsg(writer_db);
+            PM_LOG(LogEvent::HISTORY_ERROR, path, error);
+            close();
+            return false;
+        }
+        
+        stopping = false;
+        worker = thread([this] { run(); });
+        opened.store(true, memory_order_release);
+        return true;
+    }
+    
+    // Écrit tout ce qui est en file puis ferme les connexions
+    void close() {
+        opened.store(false, memory_order_release);
+        if (worker.joinable()) {
+            {
+                lock_guard<mutex> lock(queue_mutex);
+                stopping = true;
+            }
+            queue_ready.notify_one();
+            worker.join();
+        }
+        for (SqliteStatement* stmt : {&insert_tick, &insert_source, &insert_signal, &insert_market, &begin_batch, &commit_batch}) {
+            stmt->reset_handle();
+        }
+        {
+            lock_guard<mutex> lock(reader_mutex);
+            select_ticks.reset_handle();
+            if (reader_db) sqlite3_close(reader_db);
+            reader_db = nullptr;
+        }
+        if (writer_db) sqlite3_close(writer_db);
+        writer_db = nullptr;
+        lock_guard<mutex> lock(queue_mutex);
+        pending_ticks.clear();
+        pending_sources.clear();
+        pending_signals.clear();
+        pending_markets.clear();
+        last_tick.clear();
+    }
+    
+    // Attend que les lignes déjà en file soient écrites
+    void flush() {
+        if (!worker.joinable()) return;
+        unique_lock<mutex> lock(queue_mutex);
+        uint64_t generation = ++flush_generation;
+        flush_requested = true;
+        queue_ready.notify_one();
+        flushed.wait(lock, [&] { return flushed_generation >= generation || stopping; });
+    }
+    
+    // Prix effectifs d'un cycle: seuls les marchés dont le prix a changé sont enregistrés
+    void record_ticks(const vector<Market>& markets, const vector<double>& prices, TickOrigin origin) {
+        if (!is_open()) return;
+        // Symboles résolus hors du verrou de file
+        vector<pair<uint32_t, double>> ticks;
+        ticks.reserve(min(markets.size(), prices.size()));
+        for (size_t i = 0; i < markets.size() && i < prices.size(); i++) {
+            ticks.push_back({market_symbols.intern(markets[i].id), prices[i]});
+        }
+        enqueue_ticks(ticks.begin(), ticks.end(), origin);
+    }
+    
+    void record_ticks(const unordered_map<uint32_t, double>& prices, TickOrigin origin) {
+        if (!is_open()) return;
+        enqueue_ticks(prices.begin(), prices.end(), origin);
+    }
+    
+    // Sources relevées dont le contenu a changé (les révalidations 304 / même empreinte ne sont pas rejouées)
+    void record_sources(const vector<SourceData>& sources) {
+        if (!is_open()) return;
+        int64_t ts = history_now_ms();
+        lock_guard<mutex> lock(queue_mutex);
+        for (const auto& data : sources) {
+            if (data.not_modified) continue;
+            if (!admit()) continue;
+            pending_sources.push_back({ts, data});
+        }
+    }
+    
+    void record_signals(const unordered_map<uint32_t, SignalRecord>& deltas) {
+        if (!is_open() || deltas.empty()) return;
+        int64_t ts = history_now_ms();
+        lock_guard<mutex> lock(queue_mutex);
+        for (const auto& entry : deltas) {
+            if (!admit()) continue;
+            pending_signals.push_back({ts, entry.second});
+        }
+    }
+    
+    // Textes de l'univers (à chaque reconstruction de l'index): le rejeu en reconstruit les mots-clés
+    void record_markets(const vector<Market>& markets) {
+        if (!is_open()) return;
+        int64_t ts = history_now_ms();
+        lock_guard<mutex> lock(queue_mutex);
+        for (const auto& market : markets) {
+            if (!admit()) continue;
+            pending_markets.push_back({ts, market.id, market.question, market.description, market.probability});
+        }
+        if (pending_rows() >= HISTORY_BATCH_ROWS) queue_ready.notify_one();
+    }
+    
+    // Ticks d'un marché dans [from_ms, to_ms], les max_rows plus récents, ordre chronologique
+    vector<pair<int64_t, double>> query_ticks(const string& market, int64_t from_ms, int64_t to_ms, size_t max_rows) {
+        vector<pair<int64_t, double>> out;
+        lock_guard<mutex> lock(reader_mutex);
+        if (!reader_db) return out;
+        select_ticks.bind(1, market);
+        select_ticks.bind(2, from_ms);
+        select_ticks.bind(3, to_ms);
+        select_ticks.bind(4, (int64_t)min(max_rows, (size_t)INT64_MAX));
+        while (sqlite3_step(select_ticks.get()) == SQLITE_ROW) {
+            out.push_back({sqlite3_column_int64(select_ticks.get(), 0), sqlite3_column_double(select_ticks.get(), 1)});
+        }
+        sqlite3_reset(select_ticks.get());
+        sqlite3_clear_bindings(select_ticks.get());
+        reverse(out.begin(), out.end());
+        return out;
+    }
+    
+    // Démarrage à chaud: dernier état connu de chaque source (ETag, empreinte, mots-clés),
+    // pour que le premier cycle revalide au lieu de tout retélécharger
+    map<string, SourceData> load_latest_sources() {
+        map<string, SourceData> out;
+        lock_guard<mutex> lock(reader_mutex);
+        if (!reader_db) return out;
+        SqliteStatement latest;
+        if (!latest.prepare(reader_db,
+                "SELECT s.url, s.ts, s.accessible, s.content_length, s.keywords, s.error, s.etag, s.last_modified,"
+                " s.content_hash, s.keyword_signature, s.truncated FROM source_snapshots s"
+                " JOIN (SELECT url, MAX(ts) AS ts FROM source_snapshots GROUP BY url) last"
+                " ON s.url = last.url AND s.ts = last.ts")) {
+            return out;
+        }
+        auto text = [&](int column) {
+            const unsigned char* value = sqlite3_column_text(latest.get(), column);
+            return value ? string((const char*)value) : string();
+        };
+        while (sqlite3_step(latest.get()) == SQLITE_ROW) {
+            SourceData data;
+            data.url = text(0);
+            data.last_check = chrono::system_clock::time_point(chrono::milliseconds(sqlite3_column_int64(latest.get(), 1)));
+            data.accessible = sqlite3_column_int(latest.get(), 2) != 0;
+            data.content_length = sqlite3_column_int(latest.get(), 3);
+            string keywords = text(4);
+            for (size_t start = 0; start < keywords.size();) {
+                size_t end = keywords.find('\n', start);
+                if (end == string::npos) end = keywords.size();
+                data.found_keywords.push_back(keywords.substr(start, end - start));
+                start = end + 1;
+            }
+            data.error = text(5);
+            data.etag = text(6);
+            data.last_modified = text(7);
+            data.content_hash = (uint64_t)sqlite3_column_int64(latest.get(), 8);
+            data.keyword_signature = (uint64_t)sqlite3_column_int64(latest.get(), 9);
+            data.truncated = sqlite3_column_int(latest.get(), 10) != 0;
+            out[data.url] = move(data);
+        }
+        return out;
+    }
+};
+
+HistoryStore history_store;
+
+// ===== REJEU (BACKTEST) =====
+// Ticks et instantanés de sources enregistrés, rejoués à vitesse maximale dans le même pipeline
+// incrémental que le live (détaché: paramètres ROI propres, aucun log, aucune statistique globale).
+// Les événements de même horodatage forment un cycle: apply() si une source a changé, sinon reprice().
+// Journal: base SQLite de HistoryStore, ou journal binaire (export_replay_log) projeté en mémoire.
+// Un rejeu est séquentiel et déterministe; le parallélisme est entre jeux de paramètres.
+enum class ReplayEventKind : uint8_t { TICK = 0, SOURCE = 1 };
+
+// POD lu tel quel depuis le journal binaire (format natif de la machine)
+struct ReplayEvent {
+    int64_t ts_ms;
+    uint32_t index;  // TICK: indice de marché, SOURCE: indice d'instantané
+    ReplayEventKind kind;
+    uint8_t reserved[3];
+    double price;    // TICK uniquement
+};
+static_assert(sizeof(ReplayEvent) == 24 && std::is_trivially_copyable<ReplayEvent>::value,
+              "ReplayEvent is mapped directly from the binary log");
+
+struct ReplaySnapshot {
+    uint32_t url;  // indice dans ReplayLog::urls
+    bool accessible;
+    vector<string> found_keywords;
+};
+
+const char REPLAY_LOG_MAGIC[8] = {'P', 'M', 'R', 'E', 'P', 'L', 'A', 'Y'};
+const uint32_t REPLAY_LOG_VERSION = 2; // 2: prix de départ connu ou non par marché
+
+// En-tête, puis les événements (tableau de ReplayEvent), puis les chaînes (marchés, URLs, instantanés)
+struct ReplayLogHeader {
+    char magic[8];
+    uint32_t version;
+    uint32_t market_count;
+    uint32_t url_count;
+    uint32_t snapshot_count;
+    uint64_t event_count;
+    uint64_t events_offset;
+    uint64_t strings_offset;
+    uint64_t strings_size;
+};
+
+// Fichier projeté en lecture seule, libéré à la destruction
+class MappedFile {
+private:
+    void* base = nullptr;
+    size_t length = 0;
+    
+public:
+    MappedFile() = default;
+    MappedFile(const MappedFile&) = delete;
+    MappedFile& operator=(const MappedFile&) = delete;
+    ~MappedFile() { reset(); }
+    
+    bool open(const string& path) {
+        reset();
+        int fd = ::open(path.c_str(), O_RDONLY);
+        if (fd < 0) return false;
+        struct stat st;
+        if (fstat(fd, &st) == 0 && st.st_size > 0) {
+            void* mapped = mmap(nullptr, (size_t)st.st_size, PROT_READ, MAP_PRIVATE, fd, 0);
+            if (mapped != MAP_FAILED) {
+                base = mapped;
+                length = (size_t)st.st_size;
+                madvise(base, length, MADV_SEQUENTIAL);
+            }
+        }
+        ::close(fd);
+        return base != nullptr;
+    }
+    
+    void reset() {
+        if (base) munmap(base, length);
+        base = nullptr;
+        length = 0;
+    }
+    
+    const char* data() const { return (const char*)base; }
+    size_t size() const { return length; }
+};
+
+class ReplayLog {
+private:
+    vector<ReplayEvent> owned_events; // chargé depuis SQLite
+    MappedFile mapped;                // ou projeté depuis le journal binaire
+    const ReplayEvent* event_data = nullptr;
+    size_t events_size = 0;
+    
+    // Section chaînes du journal binaire: u32 longueur + octets
+    struct Reader {
+        const char* pos;
+        const char* end;
+        bool ok = true;
+        template <typename T>
+        T pod() {
+            T value{};
+            if ((size_t)(end - pos) < sizeof(T)) ok = false;
+            else memcpy(&value, pos, sizeof(T)), pos += sizeof(T);
+            return value;
+        }
+        string str() {
+            uint32_t len = pod<uint32_t>();
+            if (!ok || (size_t)(end - pos) < len) {
+                ok = false;
+                return string();
+            }
+            string value(pos, len);
+            pos += len;
+            return value;
+        }
+    };
+    
+    template <typename T>
+    static void put(string& out, const T& value) { out.append((const char*)&value, sizeof(T)); }
+    static void put_str(string& out, const string& value) {
+        put(out, (uint32_t)value.size());
+        out += value;
+    }
+    
+    // Symboles, index de mots-clés et prix de départ (markets[m].probability, fixé au chargement)
+    void finish() {
+        market_symbol.resize(markets.size());
+        market_by_symbol.clear();
+        for (size_t m = 0; m < markets.size(); m++) {
+            market_symbol[m] = market_symbols.intern(markets[m].id);
+            market_by_symbol.emplace(market_symbol[m], (uint32_t)m);
+        }
+        for (const auto& url : urls) source_symbols.intern(url);
+        index = make_shared<const MarketKeywordIndex>(markets);
+        
+        initial_prices.resize(markets.size());
+        for (size_t m = 0; m < markets.size(); m++) initial_prices[m] = markets[m].probability;
+        initial_priced.resize(markets.size(), false);
+    }
+    
+    void clear() {
+        markets.clear();
+        urls.clear();
+        snapshots.clear();
+        initial_priced.clear();
+        owned_events.clear();
+        mapped.reset();
+        event_data = nullptr;
+        events_size = 0;
+    }
+    
+public:
+    vector<Market> markets;  // univers (ordre des ids)
+    vector<string> urls;
+    vector<ReplaySnapshot> snapshots;
+    
+    shared_ptr<const MarketKeywordIndex> index;
+    vector<uint32_t> market_symbol;                      // indice de marché -> symbole
+    unordered_map<uint32_t, uint32_t> market_by_symbol;  // symbole -> indice de marché
+    vector<double> initial_prices;
+    vector<bool> initial_priced; // prix connu au début de la fenêtre (sinon neutre jusqu'au premier tick)
+    
+    const ReplayEvent* events() const { return event_data; }
+    size_t event_count() const { return events_size; }
+    
+    // Base HistoryStore: univers de la table markets, ticks et sources dans [from_ms, to_ms].
+    // Prix de départ sans biais d'anticipation: dernier tick avant from_ms, sinon probabilité
+    // enregistrée si elle date d'avant from_ms, sinon 0.5 (marché non valorisé jusqu'à son premier tick)
+    bool load_sqlite(const string& path, int64_t from_ms, int64_t to_ms, string& error) {
+        clear();
+        sqlite3* db = nullptr;
+        if (sqlite3_open_v2(path.c_str(), &db, SQLITE_OPEN_READONLY | SQLITE_OPEN_NOMUTEX, nullptr) != SQLITE_OK) {
+            error = db ? sqlite3_errmsg(db) : "open";
+            if (db) sqlite3_close(db);
+            return false;
+        }
+        
+        auto text = [](sqlite3_stmt* stmt, int column) {
+            const unsigned char* value = sqlite3_column_text(stmt, column);
+            return value ? string((const char*)value) : string();
+        };
+        unordered_map<string, uint32_t> market_ids;
+        unordered_map<string, uint32_t> url_ids;
+        vector<pair<ReplayEvent, uint64_t>> merged; // (événement, ordre d'insertion) pour un tri stable
+        
+        {
+            SqliteStatement select;
+            if (!select.prepare(db, "SELECT id, question, description, probability, ts FROM markets ORDER BY id")) {
+                error = sqlite3_errmsg(db);
+            }
+            while (select.get() && sqlite3_step(select.get()) == SQLITE_ROW) {
+                Market market;
+                market.id = text(select.get(), 0);
+                market.question = text(select.get(), 1);
+                market.description = text(select.get(), 2);
+                bool known = sqlite3_column_int64(select.get(), 4) <= from_ms;
+                market.probability = known ? sqlite3_column_double(select.get(), 3) : 0.5;
+                market_ids.emplace(market.id, (uint32_t)markets.size());
+                markets.push_back(move(market));
+                initial_priced.push_back(known);
+            }
+        }
+        if (error.empty()) {
+            // Colonnes nues avec MAX(): valeurs de la ligne du tick le plus récent (SQLite)
+            SqliteStatement select;
+            if (!select.prepare(db, "SELECT market, price, MAX(ts) FROM ticks WHERE ts < ?1 GROUP BY market")) {
+                error = sqlite3_errmsg(db);
+            } else {
+                select.bind(1, from_ms);
+                while (sqlite3_step(select.get()) == SQLITE_ROW) {
+                    auto market = market_ids.find(text(select.get(), 0));
+                    if (market == market_ids.end()) continue;
+                    markets[market->second].probability = sqlite3_column_double(select.get(), 1);
+                    initial_priced[market->second] = true;
+                }
+            }
+        }
+        if (error.empty()) {
+            SqliteStatement select;
+            if (!select.prepare(db, "SELECT market, ts, price FROM ticks WHERE ts >= ?1 AND ts <= ?2 ORDER BY ts, rowid")) {
+                error = sqlite3_errmsg(db);
+            } else {
+                select.bind(1, from_ms);
+                select.bind(2, to_ms);
+                while (sqlite3_step(select.get()) == SQLITE_ROW) {
+                    auto market = market_ids.find(text(select.get(), 0));
+                    if (market == market_ids.end()) continue; // marché sans texte enregistré
+                    ReplayEvent e{};
+                    e.ts_ms = sqlite3_column_int64(select.get(), 1);
+                    e.index = market->second;
+                    e.kind = ReplayEventKind::TICK;
+                    e.price = sqlite3_column_double(select.get(), 2);
+                    merged.push_back({e, merged.size()});
+                }
+            }
+        }
+        if (error.empty()) {
+            SqliteStatement select;
+            if (!select.prepare(db, "SELECT url, ts, accessible, keywords FROM source_snapshots"
+                                    " WHERE ts >= ?1 AND ts <= ?2 ORDER BY ts, rowid")) {
+                error = sqlite3_errmsg(db);
+            } else {
+                select.bind(1, from_ms);
+                select.bind(2, to_ms);
+                while (sqlite3_step(select.get()) == SQLITE_ROW) {
+                    string url = text(select.get(), 0);
+                    auto id = url_ids.emplace(url, (uint32_t)urls.size());
+                    if (id.second) urls.push_back(url);
+                    ReplaySnapshot snapshot{id.first->second, sqlite3_column_int(select.get(), 2) != 0, {}};
+                    string keywords = text(select.get(), 3);
+                    for (size_t start = 0; start < keywords.size();) {
+                        size_t end = keywords.find('\n', start);
+                        if (end == string::npos) end = keywords.size();
+                        snapshot.found_keywords.push_back(keywords.substr(start, end - start));
+                        start = end + 1;
+                    }
+                    ReplayEvent e{};
+                    e.ts_ms = sqlite3_column_int64(select.get(), 1);
+                    e.index = (uint32_t)snapshots.size();
+                    e.kind = ReplayEventKind::SOURCE;
+                    snapshots.push_back(move(snapshot));
+                    merged.push_back({e, merged.size()});
+                }
+            }
+        }
+        sqlite3_close(db);
+        if (!error.empty()) {
+            clear();
+            return false;
+        }
+        
+        sort(merged.begin(), merged.end(), [](const pair<ReplayEvent, uint64_t>& a, const pair<ReplayEvent, uint64_t>& b) {
+            return a.first.ts_ms != b.first.ts_ms ? a.first.ts_ms < b.first.ts_ms : a.second < b.second;
+        });
+        owned_events.reserve(merged.size());
+        for (const auto& entry : merged) owned_events.push_back(entry.first);
+        event_data = owned_events.data();
+        events_size = owned_events.size();
+        finish();
+        return true;
+    }
+    
+    bool save_binary(const string& path, string& error) const {
+        string strings;
+        for (size_t m = 0; m < markets.size(); m++) {
+            put_str(strings, markets[m].id);
+            put_str(strings, markets[m].question);
+            put_str(strings, markets[m].description);
+            put(strings, markets[m].probability);
+            put(strings, (uint8_t)initial_priced[m]);
+        }
+        for (const auto& url : urls) put_str(strings, url);
+        for (const auto& snapshot : snapshots) {
+            put(strings, snapshot.url);
+            put(strings, (uint8_t)snapshot.accessible);
+            put(strings, (uint32_t)snapshot.found_keywords.size());
+            for (const auto& keyword : snapshot.found_keywords) put_str(strings, keyword);
+        }
+        
+        ReplayLogHeader header{};
+        memcpy(header.magic, REPLAY_LOG_MAGIC, sizeof(header.magic));
+        header.version = REPLAY_LOG_VERSION;
+        header.market_count = (uint32_t)markets.size();
+        header.url_count = (uint32_t)urls.size();
+        header.snapshot_count = (uint32_t)snapshots.size();
+        header.event_count = events_size;
+        header.events_offset = sizeof(ReplayLogHeader);
+        header.strings_offset = header.events_offset + events_size * sizeof(ReplayEvent);
+        header.strings_size = strings.size();
+        
+        ofstream out(path, ios::binary | ios::trunc);
+        out.write((const char*)&header, sizeof(header));
+        out.write((const char*)event_data, (streamsize)(events_size * sizeof(ReplayEvent)));
+        out.write(strings.data(), (streamsize)strings.size());
+        out.close();
+        if (!out) error = "write " + path;
+        return (bool)out;
+    }
+    
+    // Événements lus sans copie depuis la projection; seules les chaînes sont matérialisées
+    bool load_binary(const string& path, string& error) {
+        clear();
+        if (!mapped.open(path)) {
+            error = "open " + path;
+            return false;
+        }
+        ReplayLogHeader header;
+        bool valid = mapped.size() >= sizeof(header);
+        if (valid) {
+            memcpy(&header, mapped.data(), sizeof(header));
+            valid = memcmp(header.magic, REPLAY_LOG_MAGIC, sizeof(header.magic)) == 0 &&
+                    header.version == REPLAY_LOG_VERSION && header.events_offset % alignof(ReplayEvent) == 0 &&
+                    header.event_count <= (mapped.size() - header.events_offset) / sizeof(ReplayEvent) &&
+                    header.strings_offset == header.events_offset + header.event_count * sizeof(ReplayEvent) &&
+                    header.strings_size <= mapped.size() - header.strings_offset;
+        }
+        
+        Reader in{valid ? mapped.data() + header.strings_offset : nullptr,
+                  valid ? mapped.data() + header.strings_offset + header.strings_size : nullptr, valid};
+        for (uint32_t i = 0; in.ok && i < header.market_count; i++) {
+            Market market;
+            market.id = in.str();
+            market.question = in.str();
+            market.description = in.str();
+            market.probability = in.pod<double>();
+            markets.push_back(move(market));
+            initial_priced.push_back(in.pod<uint8_t>() != 0);
+        }
+        for (uint32_t i = 0; in.ok && i < header.url_count; i++) urls.push_back(in.str());
+        for (uint32_t i = 0; in.ok && i < header.snapshot_count; i++) {
+            ReplaySnapshot snapshot;
+            snapshot.url = in.pod<uint32_t>();
+            snapshot.accessible = in.pod<uint8_t>() != 0;
+            uint32_t count = in.pod<uint32_t>();
+            for (uint32_t k = 0; in.ok && k < count; k++) snapshot.found_keywords.push_back(in.str());
+            in.ok = in.ok && snapshot.url < urls.size();
+            snapshots.push_back(move(snapshot));
+        }
+        
+        if (in.ok) {
+            event_data = (const ReplayEvent*)(mapped.data() + header.events_offset);
+            events_size = header.event_count;
+            for (size_t i = 0; in.ok && i < events_size; i++) {
+                const ReplayEvent& e = event_data[i];
+                size_t limit = e.kind == ReplayEventKind::TICK ? markets.size()
+                             : e.kind == ReplayEventKind::SOURCE ? snapshots.size() : 0;
+                in.ok = e.index < limit && (i == 0 || event_data[i - 1].ts_ms <= e.ts_ms);
+            }
+        }
+        if (!in.ok) {
+            error = "invalid replay log " + path;
+            clear();
+            return false;
+        }
+        finish();
+        return true;
+    }
+    
+    // Journal binaire si l'en-tête correspond, sinon base SQLite (fenêtre [from_ms, to_ms])
+    bool load(const string& path, int64_t from_ms, int64_t to_ms, string& error) {
+        char magic[sizeof(REPLAY_LOG_MAGIC)] = {};
+        ifstream probe(path, ios::binary);
+        if (!probe) {
+            error = "open " + path;
+            return false;
+        }
+        probe.read(magic, sizeof(magic));
+        bool binary = probe.gcount() == sizeof(magic) && memcmp(magic, REPLAY_LOG_MAGIC, sizeof(magic)) == 0;
+        return binary ? load_binary(path, error) : load_sqlite(path, from_ms, to_ms, error);
+    }
+};
+
+// Résultat d'un rejeu: compteurs, PnL simulé du trade automatique et empreinte des signaux
+// (deux rejeux du même journal avec les mêmes paramètres donnent la même empreinte)
+struct ReplayResult {
+    uint64_t events = 0;
+    uint64_t cycles = 0;
+    uint64_t signals = 0;     // deltas émis
+    uint64_t executions = 0;  // deltas EXECUTED_*
+    uint64_t trades = 0;      // positions clôturées
+    uint64_t wins = 0;
+    double pnl = 0.0;         // € pour une mise de stake par trade
+    double max_drawdown = 0.0;
+    uint64_t signal_hash = 1469598103934665603ULL;
+};
+
+const double REPLAY_STAKE = 1.0; // 1€ sur le trade exécuté, comme le live
+
+inline uint64_t replay_hash(uint64_t h, uint64_t value) {
+    for (int i = 0; i < 8; i++) {
+        h ^= (value >> (i * 8)) & 0xff;
+        h *= 1099511628211ULL;
+    }
+    return h;
+}
+
+inline uint64_t replay_bits(double value) {
+    uint64_t bits;
+    memcpy(&bits, &value, sizeof(bits));
+    return bits;
+}
+
+// Position ouverte sur le trade exécuté: achat au prix du modèle (côté parié + rattrapage),
+// revente au prix du côté parié quand le meilleur trade change ou en fin de journal.
+// Frais sur le profit uniquement, coût fixe par part inclus dans le prix d'entrée.
+struct ReplayPosition {
+    uint32_t market = StringInterner::NONE; // indice de marché
+    bool bet_on_yes = false;
+    double shares = 0.0;
+};
+
+void replay_close(ReplayPosition& position, const vector<double>& prices, const RoiContext& params,
+                  ReplayResult& result, double& peak) {
+    if (position.market == StringInterner::NONE) return;
+    double side_price = position.bet_on_yes ? prices[position.market] : 1.0 - prices[position.market];
+    double profit = position.shares * side_price - REPLAY_STAKE;
+    result.pnl += profit > 0.0 ? profit * (1.0 - params.fee) : profit;
+    result.trades++;
+    if (profit > 0.0) result.wins++;
+    peak = max(peak, result.pnl);
+    result.max_drawdown = max(result.max_drawdown, peak - result.pnl);
+    position.market = StringInterner::NONE;
+}
+
+void replay_open(ReplayPosition& position, uint32_t market, const vector<double>& prices, const RoiContext& params) {
+    RoiBreakdown entry = params.breakdown(prices[market]);
+    position.market = market;
+    position.bet_on_yes = entry.bet_on_yes;
+    position.shares = REPLAY_STAKE / (entry.buy_price + params.fixed_cost);
+}
+
+// Un rejeu complet; trace (optionnelle): un delta par ligne CSV, marchés dans l'ordre du journal
+ReplayResult replay_run(const ReplayLog& log, const RoiContext& params, FILE* trace = nullptr) {
+    ReplayResult result;
+    IncrementalSignalPipeline pipeline;
+    pipeline.detach(params);
+    
+    vector<double> prices = log.initial_prices;
+    vector<bool> priced = log.initial_priced;
+    map<string, SourceData> sources;
+    unordered_map<uint32_t, double> ticks;
+    vector<pair<uint32_t, SignalRecord>> ordered; // trace: deltas par indice de marché
+    ReplayPosition position;
+    double peak = 0.0;
+    bool loaded = false;
+    
+    const ReplayEvent* events = log.events();
+    size_t n = log.event_count();
+    for (size_t i = 0; i < n;) {
+        int64_t ts = events[i].ts_ms;
+        bool sources_changed = false;
+        ticks.clear();
+        for (; i < n && events[i].ts_ms == ts; i++) {
+            const ReplayEvent& e = events[i];
+            if (e.kind == ReplayEventKind::TICK) {
+                prices[e.index] = e.price;
+                priced[e.index] = true;
+                ticks[log.market_symbol[e.index]] = e.price;
+            } else {
+                const ReplaySnapshot& snapshot = log.snapshots[e.index];
+                SourceData& data = sources[log.urls[snapshot.url]];
+                data.url = log.urls[snapshot.url];
+                data.accessible = snapshot.accessible;
+                data.found_keywords = snapshot.found_keywords;
+                sources_changed = true;
+            }
+            result.events++;
+        }
+        
+        if (!loaded || sources_changed) pipeline.apply(log.markets, log.index, sources, &prices);
+        else pipeline.reprice(ticks);
+        loaded = true;
+        result.cycles++;
+        
+        // Empreinte indépendante de l'ordre des deltas dans le cycle
+        auto deltas = pipeline.take_cycle_deltas();
+        uint64_t cycle_hash = 0;
+        for (const auto& entry : deltas) {
+            const SignalRecord& r = entry.second;
+            uint64_t h = replay_hash(1469598103934665603ULL, log.market_by_symbol.at(r.market));
+            h = replay_hash(h, ((uint64_t)r.action << 8) | (uint64_t)r.executed);
+            h = replay_hash(h, replay_bits(r.roi_v2));
+            h = replay_hash(h, replay_bits(r.relevance));
+            cycle_hash ^= h;
+            result.signals++;
+            if (r.executed) result.executions++;
+        }
+        if (!deltas.empty()) result.signal_hash = replay_hash(replay_hash(result.signal_hash, (uint64_t)ts), cycle_hash);
+        
+        if (trace && !deltas.empty()) {
+            ordered.clear();
+            for (const auto& entry : deltas) ordered.push_back({log.market_by_symbol.at(entry.first), entry.second});
+            sort(ordered.begin(), ordered.end(), [](const pair<uint32_t, SignalRecord>& a, const pair<uint32_t, SignalRecord>& b) {
+                return a.first < b.first;
+            });
+            for (const auto& entry : ordered) {
+                const SignalRecord& r = entry.second;
+                fprintf(trace, "%lld,%s,%s,%s,%.17g,%.17g,%.17g\n", (long long)ts, log.markets[entry.first].id.c_str(),
+                        action_name(r.action, r.executed), source_symbols.name(r.source).c_str(), r.relevance,
+                        r.roi_v2, prices[entry.first]);
+            }
+        }
+        
+        // Trade automatique: la position suit le trade exécuté par le pipeline; pas d'ouverture
+        // sur un marché encore sans prix observé
+        uint32_t executed = pipeline.executed();
+        uint32_t target = executed == StringInterner::NONE ? StringInterner::NONE : log.market_by_symbol.at(executed);
+        if (target != StringInterner::NONE && !priced[target]) target = StringInterner::NONE;
+        if (target != position.market) {
+            replay_close(position, prices, params, result, peak);
+            if (target != StringInterner::NONE) replay_open(position, target, prices, params);
+        }
+    }
+    replay_close(position, prices, params, result, peak); // valorisée au dernier prix du journal
+    return result;
+}
+
+// Balayage de paramètres: un rejeu par jeu, répartis sur threads; résultats dans l'ordre de grid.
+// trace_prefix non vide: deltas du jeu i dans <trace_prefix>.<i>.csv (écriture tamponnée)
+vector<ReplayResult> replay_sweep(const ReplayLog& log, const vector<RoiContext>& grid, size_t threads,
+                                  const string& trace_prefix = "") {
+    vector<ReplayResult> results(grid.size());
+    parallel_for_stealing(grid.size(), threads, [&](size_t run) {
+        FILE* trace = nullptr;
+        if (!trace_prefix.empty()) {
+            trace = fopen((trace_prefix + "." + to_string(run) + ".csv").c_str(), "w");
+            if (trace) {
+                setvbuf(trace, nullptr, _IOFBF, 1 << 20);
+                fprintf(trace, "ts_ms,market,action,source,relevance,roi_v2,price\n");
+            }
+        }
+        results[run] = replay_run(log, grid[run], trace);
+        if (trace) fclose(trace);
+    });
+    return results;
+}
+
+// ===== PLANIFICATION DES SOURCES =====
+// Chaque source est interrogée selon la valeur attendue d'un nouveau relevé:
+//   P(changement depuis le dernier relevé) = 1 - exp(-λ·Δt), λ = taux de changement observé
+//   valeur = P × (1 + marchés dépendants) × (1 + ROI v2 positif cumulé / 100)
+// divisée par la latence mesurée de l'hôte (une source lente consomme plus du budget).
+// Un seau de jetons limite le nombre global de requêtes par seconde.
+const vector<string> DEFAULT_RESOLUTION_SOURCES = {
+    "https://fred.stlouisfed.org/series/FGEXPND",
+    "https://www.federalreserve.gov/monetarypolicy/openmarket.htm",
+    "https://www.bea.gov/data/gdp/gross-domestic-product",
+    "https://www.nber.org/",
+    "https://www.whitehouse.gov/",
+    "https://www.foxnews.com/",
+    "https://www.cnn.com/",
+    "https://www.sec.gov/",
+    "https://www.coinbase.com/",
+    "https://www.ethereum.org/"
+};
+
+const size_t MAX_SCHEDULED_SOURCES = 256;
+const double SOURCE_MIN_INTERVAL_S = 2.0;     // jamais plus souvent
+const double SOURCE_MAX_INTERVAL_S = 600.0;   // toujours au moins aussi souvent (si le budget le permet)
+const double SOURCE_MIN_CHANGE_PROBABILITY = 0.02;
+const double SOURCE_PRIOR_CHANGES = 0.5;      // a priori: un demi-changement ...
+const double SOURCE_PRIOR_SECONDS = 600.0;    // ... par 10 minutes
+const double SOURCE_BUDGET_BURST_S = 10.0;    // capacité du seau, en secondes de budget
+
+std::atomic<double> source_request_budget{2.0}; // requêtes par seconde, toutes sources
+
+class SourceScheduler {
+private:
+    struct Entry {
+        string url;
+        string host;
+        uint32_t source;
+        double changes = 0.0;
+        double observed_s = 0.0;          // temps cumulé entre relevés
+        bool polled = false;
+        chrono::steady_clock::time_point last_poll;
+        size_t dependents = 0;
+        double roi_potential = 0.0;
+    };
+    
+    mutable mutex schedule_mutex;
+    vector<Entry> entries;
+    unordered_map<string, size_t> by_url;
+    unordered_map<string, vector<uint32_t>> markets_by_host; // hôtes cités par les descriptions
+    double tokens = 0.0;
+    chrono::steady_clock::time_point last_refill = chrono::steady_clock::now();
+    
+    static double change_rate(const Entry& entry) {
+        return (entry.changes + SOURCE_PRIOR_CHANGES) / (entry.observed_s + SOURCE_PRIOR_SECONDS);
+    }
+    
+public:
+    SourceScheduler() {
+        for (const auto& url : DEFAULT_RESOLUTION_SOURCES) add(url);
+    }
+    
+    // false si l'URL est invalide, déjà planifiée ou si la limite est atteinte
+    bool add(const string& url) {
+        if (url.compare(0, 7, "http://") != 0 && url.compare(0, 8, "https://") != 0) return false;
+        lock_guard<mutex> lock(schedule_mutex);
+        if (by_url.count(url) || entries.size() >= MAX_SCHEDULED_SOURCES) return false;
+        Entry entry;
+        entry.url = url;
+        entry.host = latency_host_key(url);
+        entry.source = source_symbols.intern(url);
+        by_url[url] = entries.size();
+        entries.push_back(move(entry));
+        return true;
+    }
+    
+    bool contains(const string& url) const {
+        lock_guard<mutex> lock(schedule_mutex);
+        return by_url.count(url) != 0;
+    }
+    
+    size_t size() const {
+        lock_guard<mutex> lock(schedule_mutex);
+        return entries.size();
+    }
+    
+    // Nouvel univers: marchés dont la description cite un hôte (source de résolution probable)
+    void set_markets(const vector<Market>& markets) {
+        unordered_map<string, vector<uint32_t>> hosts;
+        for (const auto& market : markets) {
+            scan_urls(market.description, [&](string_view url) {
+                auto& list = hosts[latency_host_key(url)];
+                uint32_t symbol = market_symbols.intern(market.id);
+                if (list.empty() || list.back() != symbol) list.push_back(symbol);
+            });
+        }
+        lock_guard<mutex> lock(schedule_mutex);
+        markets_by_host = move(hosts);
+    }
+    
+    // Demande par source d'après le dernier cycle (appelé sous update_mutex)
+    void refresh_demand(const IncrementalSignalPipeline& pipeline) {
+        lock_guard<mutex> lock(schedule_mutex);
+        for (auto& entry : entries) {
+            auto demand = pipeline.source_demand(entry.source);
+            entry.dependents = demand.first;
+            entry.roi_potential = demand.second;
+            auto cited = markets_by_host.find(entry.host);
+            if (cited == markets_by_host.end()) continue;
+            entry.dependents += cited->second.size();
+            for (uint32_t market : cited->second) entry.roi_potential += max(0.0, pipeline.market_roi_v2(market));
+        }
+    }
+    
+    // Sources à interroger maintenant, par valeur attendue décroissante, dans la limite du budget
+    vector<string> due(chrono::steady_clock::time_point now) {
+        double budget = max(0.0, source_request_budget.load(memory_order_relaxed));
+        lock_guard<mutex> lock(schedule_mutex);
+        double elapsed = chrono::duration<double>(now - last_refill).count();
+        last_refill = now;
+        tokens = min(tokens + budget * elapsed, max(1.0, budget * SOURCE_BUDGET_BURST_S));
+        
+        struct Candidate {
+            bool forced;
+            double score;
+            size_t entry;
+        };
+        vector<Candidate> candidates;
+        for (size_t i = 0; i < entries.size(); i++) {
+            const Entry& entry = entries[i];
+            if (!entry.polled) {
+                candidates.push_back({true, INFINITY, i});
+                continue;
+            }
+            double since = chrono::duration<double>(now - entry.last_poll).count();
+            if (since < SOURCE_MIN_INTERVAL_S) continue;
+            double p_change = 1.0 - exp(-change_rate(entry) * since);
+            bool forced = since >= SOURCE_MAX_INTERVAL_S;
+            if (!forced && p_change < SOURCE_MIN_CHANGE_PROBABILITY) continue;
+            double value = p_change * (1.0 + entry.dependents) * (1.0 + entry.roi_potential / 100.0);
+            double cost = predicted_latency(entry.host) + 0.05;
+            candidates.push_back({forced, forced ? since : value / cost, i});
+        }
+        sort(candidates.begin(), candidates.end(), [](const Candidate& a, const Candidate& b) {
+            if (a.forced != b.forced) return a.forced;
+            return a.score > b.score;
+        });
+        
+        vector<string> urls;
+        for (const auto& candidate : candidates) {
+            if (tokens < 1.0) break;
+            tokens -= 1.0;
+            urls.push_back(entries[candidate.entry].url);
+        }
+        return urls;
+    }
+    
+    // Résultats d'un relevé: met à jour le taux de changement de chaque source interrogée
+    void observe(const vector<SourceData>& polled, const map<string, SourceData>& previous,
+                 chrono::steady_clock::time_point now) {
+        lock_guard<mutex> lock(schedule_mutex);
+        for (const auto& data : polled) {
+            auto it = by_url.find(data.url);
+            if (it == by_url.end()) continue;
+            Entry& entry = entries[it->second];
+            if (entry.polled) {
+                entry.observed_s += chrono::duration<double>(now - entry.last_poll).count();
+                auto before = previous.find(data.url);
+                // Scan tronqué (sans empreinte): changement = autre jeu de mots-clés
+                bool changed = data.accessible && !data.not_modified &&
+                               (data.content_hash != 0 || before == previous.end() ||
+                                before->second.found_keywords != data.found_keywords);
+                if (changed) entry.changes += 1.0;
+            }
+            entry.polled = true;
+            entry.last_poll = now;
+        }
+    }
+    
+    // Changements par seconde estimés (NaN si non planifiée)
+    double change_rate(const string& url) const {
+        lock_guard<mutex> lock(schedule_mutex);
+        auto it = by_url.find(url);
+        return it == by_url.end() ? NAN : change_rate(entries[it->second]);
+    }
+};
+
+SourceScheduler source_scheduler;
+
+// ===== INSTANTANÉS FFI SANS COPIE =====
+// Après chaque cycle qui change l'état, un bloc immuable est publié: enregistrements POD
+// *_C dont les chaînes pointent dans un pool contigu du même bloc. Rust emprunte le bloc
+// par pointeur (acquire) et le rend par numéro de génération (release); le bloc reste
+// valide tant qu'il est emprunté, même si une génération plus récente est publiée.
+// Textes des marchés: reconstruits seulement quand l'univers change, partagés entre
+// générations (une mise à jour de prix ne recopie que les enregistrements Market_C)
+struct MarketTextBlock {
+    shared_ptr<const vector<Market>> source;
+    vector<Market_C> records;
+    vector<char> string_pool;
+};
+
+struct CoreSnapshot {
+    uint64_t generation = 0;
+    shared_ptr<const MarketTextBlock> market_text;
+    vector<Market_C> markets;
+    vector<ArbitrageOpportunity_C> opportunities;
+    vector<TradingSignal_C> signals;
+    vector<char> string_pool;
+};
+
+// Construit le pool en deux passes: offsets d'abord, pointeurs une fois le pool figé
+class StringPoolBuilder {
+private:
+    vector<char>& pool;
+    vector<pair<char**, size_t>> fixups;
+    
+public:
+    explicit StringPoolBuilder(vector<char>& target) : pool(target) {}
+    
+    void add(char** field, const string& value) {
+        fixups.push_back({field, pool.size()});
+        pool.insert(pool.end(), value.begin(), value.end());
+        pool.push_back('\0');
+    }
+    
+    void add(char** field, const char* value) { add(field, string(value)); }
+    
+    void finish() {
+        for (const auto& fixup : fixups) *fixup.first = pool.data() + fixup.second;
+    }
+};
+
+atomic<uint64_t> snapshot_generation{0};
+shared_ptr<const CoreSnapshot> published_snapshot; // std::atomic_load / std::atomic_store
+
+mutex snapshot_leases_mutex; // ne protège que la table des emprunts, jamais l'état du core
+unordered_map<uint64_t, pair<shared_ptr<const CoreSnapshot>, uint32_t>> snapshot_leases;
+
+shared_ptr<const MarketTextBlock> build_market_text_block(shared_ptr<const vector<Market>> market_list) {
+    auto block = make_shared<MarketTextBlock>();
+    block->source = market_list;
+    block->records.resize(market_list->size());
+    StringPoolBuilder strings(block->string_pool);
+    for (size_t i = 0; i < market_list->size(); i++) {
+        const Market& market = (*market_list)[i];
+        Market_C& out = block->records[i];
+        strings.add(&out.id, market.id);
+        strings.add(&out.question, market.question);
+        strings.add(&out.description, market.description);
+        strings.add(&out.domain, market.domain);
+        strings.add(&out.resolution_source, market.resolution_source);
+        out.probability = market.probability;
+    }
+    strings.finish();
+    return block;
+}
+
+shared_ptr<const MarketTextBlock> last_market_text; // protégé par update_mutex
+
+// prices: probabilité effective par marché (même taille que market_list), ou vide
+void publish_core_snapshot(const shared_ptr<const vector<Market>>& market_list, const vector<double>& prices,
+                           const OpportunityColumns& opps, const vector<SignalRecord>& records) {
+    if (!last_market_text || last_market_text->source != market_list) {
+        last_market_text = build_market_text_block(market_list);
+    }
+    
+    auto snapshot = make_shared<CoreSnapshot>();
+    snapshot->generation = snapshot_generation.fetch_add(1, memory_order_relaxed) + 1;
+    snapshot->market_text = last_market_text;
+    snapshot->markets = last_market_text->records;
+    if (prices.size() == snapshot->markets.size()) {
+        for (size_t i = 0; i < prices.size(); i++) snapshot->markets[i].probability = prices[i];
+    }
+    snapshot->opportunities.resize(opps.size());
+    snapshot->signals.resize(records.size());
+    
+    StringPoolBuilder strings(snapshot->string_pool);
+    for (size_t i = 0; i < opps.size(); i++) {
+        ArbitrageOpportunity_C& out = snapshot->opportunities[i];
+        strings.add(&out.market_id, market_symbols.name(opps.market[i]));
+        strings.add(&out.source_url, source_symbols.name(opps.source[i]));
+        strings.add(&out.confidence, confidence_name(opps.confidence[i]));
+        strings.add(&out.reason, opps.reason(i));
+        out.relevance_score = opps.relevance[i];
+        out.potential_roi_v1 = opps.roi_v1[i];
+        out.potential_roi_v2 = opps.roi_v2[i];
+    }
+    for (size_t i = 0; i < records.size(); i++) {
+        const SignalRecord& record = records[i];
+        TradingSignal_C& out = snapshot->signals[i];
+        strings.add(&out.market_id, market_symbols.name(record.market));
+        strings.add(&out.action, action_name(record.action, record.executed));
+        strings.add(&out.confidence, confidence_name(record.confidence));
+        strings.add(&out.source_url, source_symbols.name(record.source));
+        strings.add(&out.reason, signal_reason(record));
+        strings.add(&out.grade, grade_name(record.grade));
+        out.potential_roi_v1 = record.roi_v1;
+        out.potential_roi_v2 = record.roi_v2;
+        out.reaction_time = record.reaction_time;
+        out.execution_time = record.execution_time;
+        out.total_time = record.total_time;
+    }
+    strings.finish();
+    
+    std::atomic_store(&published_snapshot, shared_ptr<const CoreSnapshot>(move(snapshot)));
+}
+
+// Publie l'état après une réévaluation du pipeline (cycle REST ou prix temps réel).
+// Appelé sous update_mutex; next est la prochaine version (copie de la dernière publiée).
+// times (optionnel): reçoit le temps de l'étape EMIT
+void publish_pipeline_state(shared_ptr<CoreState> next, bool pipeline_changed, StageTimes* times = nullptr) {
+    uint64_t start_ns = pipeline_clock_ns();
+    if (pipeline_changed || signal_pipeline.snapshot_stale() || !std::atomic_load(&published_snapshot)) {
+        next->signals = make_shared<const vector<SignalRecord>>(signal_pipeline.snapshot());
+        next->opportunities = make_shared<const OpportunityColumns>(signal_pipeline.opportunities());
+        next->prices = make_shared<const vector<double>>(signal_pipeline.prices());
+        publish_core_snapshot(next->markets, *next->prices, *next->opportunities, *next->signals);
+    }
+    auto deltas = signal_pipeline.take_cycle_deltas();
+    history_store.record_signals(deltas);
+    uint64_t published_ns = pipeline_clock_ns();
+    for (const auto& entry : deltas) pipeline_stats.end_to_end.record_value(published_ns - entry.second.observed_ns);
+    signal_deltas.push(move(deltas));
+    publish_core_state(move(next));
+    if (times) times->lap(PipelineStage::EMIT, start_ns);
+}
+
+// Prix temps réel d'un lot de marchés (symbole -> probabilité): réévaluation ciblée
+// times: temps déjà passé sur le lot (PARSE); observed_ns: réception du premier message du lot
+void apply_live_prices(const unordered_map<uint32_t, double>& prices, StageTimes times = {}, uint64_t observed_ns = 0) {
+    history_store.record_ticks(prices, TickOrigin::FEED);
+    lock_guard<mutex> writer(update_mutex);
+    auto previous = std::atomic_load(&core_state);
+    if (previous->markets->empty()) return;
+    
+    size_t changed = signal_pipeline.reprice(prices, &times, observed_ns);
+    if (changed > 0) {
+        auto next = make_shared<CoreState>(*previous);
+        next->version = previous->version + 1;
+        publish_pipeline_state(move(next), true, &times);
+    }
+    pipeline_stats.record(times);
+}
+
+// ===== WEBSOCKET (RFC 6455) =====
+// Connexion TCP/TLS ouverte par curl (CONNECT_ONLY), poignée de main HTTP/1.1 et trames
+// gérées ici: ne dépend pas du support WebSocket expérimental de libcurl.
+string base64_encode(const unsigned char* data, size_t len) {
+    static const char table[] = "ABCDEFGHIJKLMNOPQRSTUVWXYZabcdefghijklmnopqrstuvwxyz0123456789+/";
+    string out;
+    out.reserve((len + 2) / 3 * 4);
+    for (size_t i = 0; i < len; i += 3) {
+        uint32_t v = (uint32_t)data[i] << 16;
+        if (i + 1 < len) v |= (uint32_t)data[i + 1] << 8;
+        if (i + 2 < len) v |= data[i + 2];
+        out += table[(v >> 18) & 63];
+        out += table[(v >> 12) & 63];
+        out += i + 1 < len ? table[(v >> 6) & 63] : '=';
+        out += i + 2 < len ? table[v & 63] : '=';
+    }
+    return out;
+}
+
+class WebSocketConnection {
+private:
+    static const size_t MAX_MESSAGE_BYTES = 16 * 1024 * 1024;
+    
+    CURL* curl = nullptr;
+    curl_socket_t sock = CURL_SOCKET_BAD;
+    string inbox;   // octets reçus pas encore découpés en trames
+    string message; // message fragmenté en cours
+    mt19937 rng{random_device{}()};
+    
+    bool wait_socket(bool for_write, int timeout_ms) {
+        pollfd pfd{};
+        pfd.fd = sock;
+        pfd.events = for_write ? POLLOUT : POLLIN;
+        return ::poll(&pfd, 1, timeout_ms) > 0;
+    }
+    
+    bool send_raw(const char* data, size_t len) {
+        while (len > 0) {
+            size_t sent = 0;
+            CURLcode rc = curl_easy_send(curl, data, len, &sent);
+            if (rc == CURLE_AGAIN) {
+                if (!wait_socket(true, 1000)) return fail("send timeout");
+                continue;
+            }
+            if (rc != CURLE_OK) return fail(curl_easy_strerror(rc));
+            data += sent;
+            len -= sent;
+        }
+        return true;
+    }
+    
+    // Lit tout ce qui est disponible sans bloquer; false si la connexion est fermée
+    bool recv_available() {
+        char buf[16384];
+        while (true) {
+            size_t n = 0;
+            CURLcode rc = curl_easy_recv(curl, buf, sizeof(buf), &n);
+            if (rc == CURLE_AGAIN) return true;
+            if (rc != CURLE_OK) return fail(curl_easy_strerror(rc));
+            if (n == 0) return fail("connection closed");
+            inbox.append(buf, n);
+        }
+    }
+    
+    // Trame client: toujours masquée
+    bool send_frame(uint8_t opcode, const char* payload, size_t len) {
+        string frame;
+        frame.reserve(len + 14);
+        frame += (char)(0x80 | opcode);
+        if (len < 126) {
+            frame += (char)(0x80 | len);
+        } else if (len <= 0xFFFF) {
+            frame += (char)(0x80 | 126);
+            frame += (char)(len >> 8);
+            frame += (char)(len & 0xFF);
+        } else {
+            frame += (char)(0x80 | 127);
+            for (int shift = 56; shift >= 0; shift -= 8) frame += (char)((uint64_t)len >> shift);
+        }
+        uint32_t key = rng();
+        char mask[4] = {(char)(key >> 24), (char)(key >> 16), (char)(key >> 8), (char)key};
+        frame.append(mask, 4);
+        for (size_t i = 0; i < len; i++) frame += (char)(payload[i] ^ mask[i & 3]);
+        return send_raw(frame.data(), frame.size());
+    }
+    
+    // Découpe les trames complètes du tampon; une trame incomplète y reste jusqu'à la
+    // lecture suivante. frames: nombre de trames consommées; false si la connexion est perdue
+    template <typename OnMessage>
+    bool deliver_frames(OnMessage& on_message, size_t& frames) {
+        size_t pos = 0;
+        while (inbox.size() - pos >= 2) {
+            const unsigned char* h = (const unsigned char*)inbox.data() + pos;
+            bool fin = h[0] & 0x80;
+            uint8_t opcode = h[0] & 0x0F;
+            bool masked = h[1] & 0x80;
+            uint64_t len = h[1] & 0x7F;
+            size_t header = 2;
+            if (len == 126) {
+                if (inbox.size() - pos < 4) break;
+                len = ((uint64_t)h[2] << 8) | h[3];
+                header = 4;
+            } else if (len == 127) {
+                if (inbox.size() - pos < 10) break;
+                len = 0;
+                for (int i = 0; i < 8; i++) len = (len << 8) | h[2 + i];
+                header = 10;
+            }
+            if (len > MAX_MESSAGE_BYTES) {
+                close();
+                return fail("frame too large");
+            }
+            size_t mask_at = header;
+            if (masked) header += 4;
+            if (inbox.size() - pos < header + len) break;
+            
+            char* payload = &inbox[pos + header];
+            if (masked) {
+                for (size_t i = 0; i < len; i++) payload[i] ^= inbox[pos + mask_at + (i & 3)];
+            }
+            pos += header + len;
+            frames++;
+            
+            switch (opcode) {
+                case 0x0: // continuation
+                case 0x1: // texte
+                case 0x2: // binaire (traité comme texte)
+                    if (opcode != 0x0) message.clear();
+                    if (message.size() + len > MAX_MESSAGE_BYTES) {
+                        close();
+                        return fail("message too large");
+                    }
+                    message.append(payload, len);
+                    if (fin) {
+                        on_message(string_view(message));
+                        message.clear();
+                    }
+                    break;
+                case 0x8: // close
+                    send_frame(0x8, payload, len < 2 ? len : 2);
+                    inbox.clear();
+                    close();
+                    return fail("closed by server");
+                case 0x9: // ping
+                    if (!send_frame(0xA, payload, len)) {
+                        close();
+                        return false;
+                    }
+                    break;
+                default: // pong
+                    break;
+            }
+        }
+        inbox.erase(0, pos);
+        return true;
+    }
+    
+    bool fail(const string& reason) {
+        error = reason;
+        return false;
+    }
+    
+public:
+    string error;
+    
+    WebSocketConnection() = default;
+    WebSocketConnection(const WebSocketConnection&) = delete;
+    WebSocketConnection& operator=(const WebSocketConnection&) = delete;
+    ~WebSocketConnection() { close(); }
+    
+    bool is_open() const { return curl != nullptr; }
+    
+    // url: ws://hôte[:port]/chemin ou wss://...
+    bool connect(const string& url, int timeout_ms = 5000) {
+        close();
+        bool tls;
+        size_t host_start;
+        if (url.compare(0, 6, "wss://") == 0) { tls = true; host_start = 6; }
+        else if (url.compare(0, 5, "ws://") == 0) { tls = false; host_start = 5; }
+        else return fail("unsupported scheme");
+        
+        size_t path_start = url.find('/', host_start);
+        string host_port = url.substr(host_start, path_start == string::npos ? string::npos : path_start - host_start);
+        string path = path_start == string::npos ? "/" : url.substr(path_start);
+        string host = host_port.substr(0, host_port.find(':'));
+        
+        curl = curl_easy_init();
+        if (!curl) return fail("curl_easy_init failed");
+        string transport_url = (tls ? "https://" : "http://") + host_port + "/";
+        curl_easy_setopt(curl, CURLOPT_URL, transport_url.c_str());
+        curl_easy_setopt(curl, CURLOPT_CONNECT_ONLY, 1L);
+        curl_easy_setopt(curl, CURLOPT_HTTP_VERSION, (long)CURL_HTTP_VERSION_1_1); // ALPN http/1.1
+        curl_easy_setopt(curl, CURLOPT_CONNECTTIMEOUT_MS, (long)timeout_ms);
+        curl_easy_setopt(curl, CURLOPT_TCP_NODELAY, 1L);
+        curl_easy_setopt(curl, CURLOPT_TCP_KEEPALIVE, 1L);
+        curl_easy_setopt(curl, CURLOPT_NOSIGNAL, 1L);
+        
+        CURLcode rc = curl_easy_perform(curl);
+        if (rc != CURLE_OK) {
+            string reason = curl_easy_strerror(rc);
+            close();
+            return fail(reason);
+        }
+        curl_easy_getinfo(curl, CURLINFO_ACTIVESOCKET, &sock);
+        
+        unsigned char nonce[16];
+        for (auto& b : nonce) b = (unsigned char)rng();
+        string request = "GET " + path + " HTTP/1.1\r\n"
+                         "Host: " + host + "\r\n"
+                         "Upgrade: websocket\r\n"
+                         "Connection: Upgrade\r\n"
+                         "Sec-WebSocket-Key: " + base64_encode(nonce, sizeof(nonce)) + "\r\n"
+                         "Sec-WebSocket-Version: 13\r\n"
+                         "User-Agent: Polymarket-Bot/1.0\r\n\r\n";
+        if (!send_raw(request.data(), request.size())) {
+            close();
+            return false;
+        }
+        
+        // Réponse 101; les octets suivant l'en-tête sont déjà des trames
+        auto deadline = chrono::steady_clock::now() + chrono::milliseconds(timeout_ms);
+        size_t header_end;
+        while ((header_end = inbox.find("\r\n\r\n")) == string::npos) {
+            int left = (int)chrono::duration_cast<chrono::milliseconds>(deadline - chrono::steady_clock::now()).count();
+            if (left <= 0 || !wait_socket(false, left) || !recv_available()) {
+                close();
+                return fail(error.empty() ? "handshake timeout" : error);
+            }
+        }
+        size_t status_end = inbox.find("\r\n");
+        if (inbox.compare(0, 9, "HTTP/1.1 ") != 0 || inbox.compare(9, 3, "101") != 0) {
+            string status = inbox.substr(0, status_end);
+            close();
+            return fail("handshake refused: " + status);
+        }
+        inbox.erase(0, header_end + 4);
+        return true;
+    }
+    
+    bool send_text(string_view text) { return send_frame(0x1, text.data(), text.size()); }
+    
+    // Délivre chaque message texte complet à on_message et attend au plus timeout_ms quand
+    // aucune trame complète n'est en tampon (trame partielle comprise: un gros snapshot "book"
+    // arrive en plusieurs lectures). Répond aux ping; false si la connexion est perdue.
+    template <typename OnMessage>
+    bool poll(int timeout_ms, OnMessage&& on_message) {
+        if (!curl) return fail("not connected");
+        size_t frames = 0;
+        if (!deliver_frames(on_message, frames)) return false;
+        if (frames > 0) return true;
+        
+        // Lecture non bloquante d'abord: avec TLS, curl peut garder des octets déjà déchiffrés
+        // que poll() sur le socket ne signale pas
+        size_t buffered = inbox.size();
+        if (!recv_available() ||
+            (inbox.size() == buffered && wait_socket(false, timeout_ms) && !recv_available())) {
+            close();
+            return false;
+        }
+        return deliver_frames(on_message, frames);
+    }
     
-    if (text.find("fed") != string::npos) keywords.push_back("federal reserve");
-    if (text.find("rate") != string::npos) keywords.push_back("interest rate");
-    if (text.find("recession") != string::npos) keywords.push_back("recession");
-    if (text.find("crypto") != string::npos) keywords.push_back("crypto");
-    if (text.find("bitcoin") != string::npos) keywords.push_back("bitcoin");
-    if (text.find("ethereum") != string::npos) keywords.push_back("ethereum");
-    
-    return keywords;
-}
+    void close() {
+        if (curl) curl_easy_cleanup(curl);
+        curl = nullptr;
+        sock = CURL_SOCKET_BAD;
+        inbox.clear();
+        message.clear();
+    }
+};
 
-// Fetch des marchés Polymarket (version simplifiée)
-vector<Market> fetch_polymarket_markets(FastHTTPClient& client) {
-    vector<Market> fetched_markets;
-    
-    auto start_time = chrono::high_resolution_clock::now();
-    
-    // Simuler la récupération de marchés (version simplifiée)
-    Market market1;
-    market1.id = "test-market-1";
-    market1.question = "Test Market Question";
-    market1.description = "Test Market Description";
-    market1.domain = "economy";
-    market1.probability = 0.5;
-    market1.resolution_source = "test-source.com";
-    market1.last_update = chrono::system_clock::now();
-    
-    fetched_markets.push_back(market1);
-    
-    auto end_time = chrono::high_resolution_clock::now();
-    auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time);
-    
-    cout << "[OK] " << fetched_markets.size() << " marchés récupérés en " << duration.count() << "ms" << endl;
-    
-    return fetched_markets;
-}
+// ===== FLUX TEMPS RÉEL DU CLOB (canal market) =====
+// Un thread tient la connexion, applique les messages "book" (instantané) et "price_change"
+// (delta de niveau) au carnet L2 du jeton "Yes" de chaque marché, et transmet les nouveaux
+// prix milieu par lots au pipeline: seuls les marchés dont le prix a bougé sont réévalués.
+const string CLOB_WS_MARKET_URL = "wss://ws-subscriptions-clob.polymarket.com/ws/market";
+const size_t MAX_FEED_ASSETS = 2000;        // assets par connexion
+const int FEED_POLL_MS = 50;
+const int FEED_PING_INTERVAL_MS = 10000;  // le serveur attend un "PING" texte régulier
+const int FEED_MAX_BACKOFF_MS = 30000;
 
-// Monitoring des sources de résolution
-SourceData monitor_resolution_source(FastHTTPClient& client, const string& url, const vector<string>& keywords) {
-    SourceData data;
-    data.url = url;
+class MarketFeed {
+private:
+    struct LevelChange {
+        string asset_id;
+        double price;
+        double size;
+        bool is_bid;
+    };
     
-    auto start_time = chrono::high_resolution_clock::now();
-    string response = client.GET(url);
-    auto end_time = chrono::high_resolution_clock::now();
+    string url = CLOB_WS_MARKET_URL;
+    thread worker;
+    atomic<bool> running{false};
     
-    if (response.empty()) {
-        data.accessible = false;
-        data.error = "Empty response";
-        return data;
-    }
+    // Abonnement demandé (asset "Yes" -> symbole de marché), repris à la reconnexion
+    mutex config_mutex;
+    vector<pair<string, uint32_t>> subscription;
+    uint64_t subscription_version = 0;
     
-    data.accessible = true;
-    data.content_length = response.length();
-    data.last_check = chrono::system_clock::now();
+    mutex live_mutex;
+    unordered_map<uint32_t, double> live_prices; // dernier prix milieu connu par marché
     
-    string lower_response = response;
-    transform(lower_response.begin(), lower_response.end(), lower_response.begin(), ::tolower);
+    // Données du thread de flux
+    unordered_map<string, uint32_t> market_by_asset;
+    unordered_map<uint32_t, double> batch;
+    StageTimes batch_times;       // décodage et mise à jour des carnets du lot (PARSE)
+    uint64_t batch_observed_ns = 0; // réception du premier message du lot
+    vector<LevelChange> changes;
+    string event_type, asset_id, side;
     
-    for (const auto& keyword : keywords) {
-        if (lower_response.find(keyword) != string::npos) {
-            data.found_keywords.push_back(keyword);
+    bool read_levels(JsonCursor& json, bool is_bid, const string& asset) {
+        if (!json.begin_array()) return false;
+        while (json.next_element()) {
+            if (!json.begin_object()) return false;
+            double price = -1.0, size = 0.0;
+            string_view key;
+            while (json.next_field(key)) {
+                if (key == "price") json.read_number(price);
+                else if (key == "size") json.read_number(size);
+                else json.skip_value();
+            }
+            if (price >= 0.0) changes.push_back({asset, price, size, is_bid});
         }
+        return json.ok();
     }
     
-    auto duration = chrono::duration_cast<chrono::milliseconds>(end_time - start_time);
-            cout << "  [OK] " << url << " (" << data.content_length << " chars, " << duration.count() << "ms)" << endl;
-    
-    return data;
-}
-
-// FORMULE ROI PROFESSIONNELLE POLYMARKET (frais 3% sur le profit uniquement)
-double calculate_real_roi(double current_price, double fee, double catchup_speed, double action_time) {
-    // Use global parameters for consistency
-    fee = GLOBAL_FEE;           // 3% fees on profit
-    catchup_speed = GLOBAL_CATCHUP_SPEED;
-    action_time = GLOBAL_ACTION_TIME;
-    double g = GLOBAL_FIXED_COST; // Fixed costs per share
-    
-    // LOGIQUE MARCHÉ BINAIRE: Décider si on parie "OUI" ou "NON"
-    bool bet_on_yes = current_price < 0.5; // Si prix < 50%, on parie "OUI"
-    
-    // Calcul du prix d'achat effectif (avec spread/slippage)
-    double p;
-    if (bet_on_yes) {
-        // Parie "OUI": prix d'achat = prix_actuel + (vitesse_rattrapage × temps_action)
-        p = current_price + (catchup_speed * action_time);
-    } else {
-        // Parie "NON": prix d'achat = (1 - prix_actuel) + (vitesse_rattrapage × temps_action)
-        p = (1.0 - current_price) + (catchup_speed * action_time);
+    // "changes" (asset dans l'événement) ou "price_changes" (asset dans chaque entrée)
+    bool read_changes(JsonCursor& json) {
+        if (!json.begin_array()) return false;
+        while (json.next_element()) {
+            if (!json.begin_object()) return false;
+            LevelChange change{"", -1.0, 0.0, true};
+            string_view key;
+            while (json.next_field(key)) {
+                if (key == "price") json.read_number(change.price);
+                else if (key == "size") json.read_number(change.size);
+                else if (key == "asset_id") json.read_string(change.asset_id);
+                else if (key == "side") {
+                    json.read_string(side);
+                    change.is_bid = strcasecmp(side.c_str(), "buy") == 0 || strcasecmp(side.c_str(), "bid") == 0;
+                } else json.skip_value();
+            }
+            if (change.price >= 0.0) changes.push_back(move(change));
+        }
+        return json.ok();
     }
     
-    // Limiter prix d'achat à des valeurs réalistes
-    if (p > 0.95) p = 0.95;
-    if (p < 0.05) p = 0.05;
-    
-    // π = proba subjective que l'événement soit YES
-    double pi_yes = 0.55;  // 55% de confiance (réaliste pour du trading quotidien)
-    
-    double expected_profit;
-    double pi_star; // seuil break-even exprimé en proba YES
-    
-    if (bet_on_yes) {
-        // Prix p = prix du YES
-        // ROI_yes = [π*(1-p)*(1-f) - (1-π)*p - g] / (p+g)
-        expected_profit = pi_yes * (1.0 - p) * (1.0 - fee)
-                        - (1.0 - pi_yes) * p - g;
-        pi_star = (p + g) / (p + (1.0 - p) * (1.0 - fee));              // seuil YES
-    } else {
-        // Prix p = prix du NO
-        // ROI_no = [(1-π)*(1-p)*(1-f) - π*p - g] / (p+g)
-        expected_profit = (1.0 - pi_yes) * (1.0 - p) * (1.0 - fee)
-                        - pi_yes * p - g;
-        pi_star = 1.0 - (p + g) / (p + (1.0 - p) * (1.0 - fee));        // seuil YES
+    void handle_event(JsonCursor& json) {
+        if (!json.begin_object()) return;
+        event_type.clear();
+        asset_id.clear();
+        changes.clear();
+        
+        string_view key;
+        while (json.next_field(key)) {
+            if (key == "event_type") json.read_string(event_type);
+            else if (key == "asset_id") json.read_string(asset_id);
+            else if (key == "bids" || key == "buys") read_levels(json, true, "");
+            else if (key == "asks" || key == "sells") read_levels(json, false, "");
+            else if (key == "changes" || key == "price_changes") read_changes(json);
+            else json.skip_value();
+        }
+        if (!json.ok()) return;
+        
+        bool snapshot = event_type == "book";
+        if (!snapshot && event_type != "price_change") return;
+        
+        auto asset_of = [&](size_t i) -> const string& {
+            return snapshot || changes[i].asset_id.empty() ? asset_id : changes[i].asset_id;
+        };
+        
+        // Un passage sous verrou par carnet (niveaux consécutifs du même jeton)
+        auto apply_run = [&](const string& asset, size_t begin, size_t end, bool clear_first) {
+            auto market = market_by_asset.find(asset);
+            if (market == market_by_asset.end()) return;
+            double mid = -1.0;
+            order_books.update(market->second, [&](L2Book& book) {
+                if (clear_first) book.clear();
+                for (size_t i = begin; i < end; i++) book.set_level(changes[i].is_bid, changes[i].price, changes[i].size);
+                mid = book.mid();
+            });
+            // Transmis même si le milieu n'a pas bougé: la profondeur sert au ROI au VWAP
+            if (mid >= 0.0) batch[market->second] = mid;
+        };
+        
+        if (snapshot) {
+            apply_run(asset_id, 0, changes.size(), true);
+            return;
+        }
+        for (size_t begin = 0; begin < changes.size();) {
+            size_t end = begin + 1;
+            while (end < changes.size() && asset_of(end) == asset_of(begin)) end++;
+            apply_run(asset_of(begin), begin, end, false);
+            begin = end;
+        }
     }
     
-    double roi = expected_profit / (p + g);
+    void handle_message(string_view text) {
+        uint64_t received_ns = pipeline_clock_ns();
+        if (batch_observed_ns == 0) batch_observed_ns = received_ns;
+        messages.fetch_add(1, memory_order_relaxed);
+        decode_message(text);
+        batch_times.lap(PipelineStage::PARSE, received_ns);
+    }
     
-    // Affichage : pi_star est en proba YES
-    cout << "[ROI PRO] Current: " << (current_price * 100) << "%, ";
-    cout << "Bet: " << (bet_on_yes ? "YES" : "NO") << ", ";
-    cout << "Buy price (p): " << fixed << setprecision(2) << (p * 100) << "%, ";
-    cout << "Confidence (π): " << (pi_yes * 100) << "%, ";
-    cout << "Break-even (π*): " << (pi_star * 100) << "%, ";
-    cout << "ROI: " << (roi * 100) << "%" << endl;
+    void decode_message(string_view text) {
+        JsonCursor json(text);
+        char first = json.peek();
+        if (first == '[') {
+            json.begin_array();
+            while (json.next_element() && json.ok()) handle_event(json);
+        } else if (first == '{') {
+            handle_event(json);
+        }
+        // Sinon: "PONG" ou texte non JSON
+    }
     
-    return roi;
-}
-
-// Arbitrage opportunity detection
-vector<ArbitrageOpportunity> detect_arbitrage_opportunities(const vector<Market>& markets, const map<string, SourceData>& sources) {
-    vector<ArbitrageOpportunity> opportunities;
+    void flush_batch() {
+        if (!batch.empty()) {
+            {
+                lock_guard<mutex> lock(live_mutex);
+                for (const auto& entry : batch) live_prices[entry.first] = entry.second;
+            }
+            price_updates.fetch_add(batch.size(), memory_order_relaxed);
+            apply_live_prices(batch, batch_times, batch_observed_ns);
+            batch.clear();
+        }
+        batch_times = StageTimes{};
+        batch_observed_ns = 0;
+    }
     
-    for (const auto& market : markets) {
-        vector<string> market_keywords = extract_market_keywords(market.question, market.description);
+    void run() {
+        WebSocketConnection ws;
+        uint64_t connected_version = 0;
+        int backoff_ms = 1000;
+        bool delivered = false; // la connexion courante a reçu au moins un message
+        auto last_ping = chrono::steady_clock::now();
         
-        for (const auto& [url, source] : sources) {
-            if (!source.accessible) continue;
-            
-            double relevance = 0.0;
-            for (const auto& keyword : market_keywords) {
-                for (const auto& found : source.found_keywords) {
-                    if (found.find(keyword) != string::npos) {
-                        relevance += 0.2;
-                    }
-                }
+        // Attente avant reconnexion, doublée à chaque échec ou coupure sans données
+        auto back_off = [&]() {
+            for (int waited = 0; waited < backoff_ms && running.load(memory_order_acquire); waited += 100) {
+                this_thread::sleep_for(chrono::milliseconds(100));
+            }
+            backoff_ms = min(backoff_ms * 2, FEED_MAX_BACKOFF_MS);
+            reconnects.fetch_add(1, memory_order_relaxed);
+        };
+        
+        while (running.load(memory_order_acquire)) {
+            vector<pair<string, uint32_t>> assets;
+            uint64_t version;
+            {
+                lock_guard<mutex> lock(config_mutex);
+                version = subscription_version;
+                if (!ws.is_open() || version != connected_version) assets = subscription;
             }
             
-            if (relevance > 0.05) {
-                ArbitrageOpportunity opp;
-                opp.market_id = market.id;
-                opp.source_url = url;
-                opp.relevance_score = relevance;
-                opp.timestamp = chrono::system_clock::now();
-                
-                if (relevance > 0.7) opp.confidence = "high";
-                else if (relevance > 0.3) opp.confidence = "medium";
-                else opp.confidence = "low";
-                
-                // ROI calculation with configurable global parameters
-                double new_roi = calculate_real_roi(market.probability, GLOBAL_FEE, GLOBAL_CATCHUP_SPEED, GLOBAL_ACTION_TIME);
-                
-                // Keep old calculations for compatibility
-                double difference = abs(0.5 - market.probability);
-                opp.potential_roi_v1 = difference * 100;
-                opp.potential_roi_v2 = new_roi * 100; // New ROI in percentage
+            if (!ws.is_open() || version != connected_version) {
+                ws.close();
+                if (assets.empty()) {
+                    this_thread::sleep_for(chrono::milliseconds(200));
+                    continue;
+                }
                 
-                opp.reason = "Source " + url + " relevant to market (score: " + to_string(relevance) + ")";
+                // Les carnets des marchés sortis de l'univers ne sont plus mis à jour
+                unordered_set<uint32_t> kept;
+                for (const auto& asset : assets) kept.insert(asset.second);
+                for (const auto& entry : market_by_asset) {
+                    if (!kept.count(entry.second)) order_books.erase(entry.second);
+                }
+                market_by_asset.clear();
+                string subscribe = "{\"type\":\"market\",\"assets_ids\":[";
+                for (size_t i = 0; i < assets.size(); i++) {
+                    if (i) subscribe += ',';
+                    subscribe += '"' + assets[i].first + '"';
+                    market_by_asset[assets[i].first] = assets[i].second;
+                }
+                subscribe += "]}";
                 
-                opportunities.push_back(opp);
+                if (!ws.connect(url) || !ws.send_text(subscribe)) {
+                    PM_LOG(LogEvent::FEED_DISCONNECTED, ws.error);
+                    ws.close();
+                    back_off();
+                    continue;
+                }
+                connected_version = version;
+                delivered = false;
+                last_ping = chrono::steady_clock::now();
+                PM_LOG(LogEvent::FEED_CONNECTED, url, assets.size());
+            }
+            
+            bool alive = ws.poll(FEED_POLL_MS, [this, &delivered](string_view text) {
+                delivered = true;
+                handle_message(text);
+            });
+            flush_batch();
+            // Le backoff n'est remis à zéro qu'une fois la connexion utile (des données reçues):
+            // un serveur qui accepte puis coupe aussitôt ne provoque pas de boucle de reconnexions
+            if (delivered) backoff_ms = 1000;
+            if (!alive) {
+                PM_LOG(LogEvent::FEED_DISCONNECTED, ws.error);
+                ws.close();
+                back_off();
+                continue;
+            }
+            
+            auto now = chrono::steady_clock::now();
+            if (now - last_ping > chrono::milliseconds(FEED_PING_INTERVAL_MS)) {
+                ws.send_text("PING");
+                last_ping = now;
             }
         }
+        ws.close();
     }
     
-    return opportunities;
-}
-
-// Priorisation des trades par ROI - sélectionne toujours le ROI le plus élevé
-// et exécute automatiquement le meilleur trade avec 1€
-vector<TradingSignal> prioritize_trades_by_roi(const vector<TradingSignal>& signals) {
-    vector<TradingSignal> prioritized_signals = signals;
-    
-    // Trier par ROI décroissant (v2 - ROI réaliste)
-    sort(prioritized_signals.begin(), prioritized_signals.end(), 
-         [](const TradingSignal& a, const TradingSignal& b) {
-             return a.potential_roi_v2 > b.potential_roi_v2;
-         });
+public:
+    atomic<uint64_t> messages{0};
+    atomic<uint64_t> price_updates{0};
+    atomic<uint64_t> reconnects{0};
     
-    // Supprimer les doublons de marché (garder seulement le ROI le plus élevé)
-    vector<TradingSignal> unique_signals;
-    set<string> processed_markets;
+    ~MarketFeed() { stop(); }
     
-    for (const auto& signal : prioritized_signals) {
-        if (processed_markets.find(signal.market_id) == processed_markets.end()) {
-            unique_signals.push_back(signal);
-            processed_markets.insert(signal.market_id);
-            
-            cout << "[PRIORITY] Trade priorisé: " << signal.market_id 
-                 << " (ROI: " << signal.potential_roi_v2 << "%, Action: " << signal.action << ")" << endl;
+    // Jetons "Yes" des marchés de l'univers (les MAX_FEED_ASSETS premiers); reconnexion si la liste change
+    void set_markets(const vector<Market>& market_list) {
+        vector<pair<string, uint32_t>> assets;
+        for (const auto& market : market_list) {
+            if (market.yes_token_id.empty()) continue;
+            assets.push_back({market.yes_token_id, market_symbols.intern(market.id)});
+            if (assets.size() == MAX_FEED_ASSETS) break;
         }
+        lock_guard<mutex> lock(config_mutex);
+        if (assets == subscription) return;
+        subscription = move(assets);
+        subscription_version++;
     }
     
-    // EXÉCUTION AUTOMATIQUE du meilleur trade
-    if (!unique_signals.empty()) {
-        TradingSignal& best_trade = unique_signals[0];
-        if (best_trade.action != "MONITOR") {
-            cout << "🚀 [EXECUTION] Trade automatique exécuté!" << endl;
-            cout << "   Market: " << best_trade.market_id << endl;
-            cout << "   Action: " << best_trade.action << endl;
-            cout << "   ROI: " << best_trade.potential_roi_v2 << "%" << endl;
-            cout << "   Montant: 1€" << endl;
-            
-            // Marquer comme exécuté
-            best_trade.action = "EXECUTED_" + string(best_trade.action);
-        }
+    // Dernier prix temps réel d'un marché (false si aucun carnet reçu)
+    bool live_price(uint32_t market_symbol, double& price) {
+        lock_guard<mutex> lock(live_mutex);
+        auto it = live_prices.find(market_symbol);
+        if (it == live_prices.end()) return false;
+        price = it->second;
+        return true;
     }
     
-    cout << "[PRIORITY] " << unique_signals.size() << " trades uniques, meilleur exécuté automatiquement" << endl;
-    return unique_signals;
-}
-
-// Trading signal generation avec priorisation par ROI
-// Priorité: ROI le plus élevé
-vector<TradingSignal> generate_trading_signals(const vector<ArbitrageOpportunity>& opportunities) {
-    vector<TradingSignal> signals;
-    
-    for (const auto& opp : opportunities) {
-        TradingSignal signal;
-        signal.market_id = opp.market_id;
-        signal.confidence = opp.confidence;
-        signal.potential_roi_v1 = opp.potential_roi_v1;
-        signal.potential_roi_v2 = opp.potential_roi_v2;
-        signal.source_url = opp.source_url;
-        signal.reason = opp.reason;
-        
-        auto start_time = chrono::high_resolution_clock::now();
-        
-        // Final decision by C++ - realistic thresholds for 4000€
-        // ROI values are in percentage (e.g., 23.9 = 23.9%)
-        if (opp.potential_roi_v2 > 2.0) { // ROI > 2%
-            signal.action = "BUY";
-            cout << "[C++ DECISION] BUY signal for " << opp.market_id << " (ROI: " << opp.potential_roi_v2 << "%)" << endl;
-        } else if (opp.potential_roi_v2 > 0.5) { // ROI > 0.5%
-            signal.action = "SELL";
-            cout << "[C++ DECISION] SELL signal for " << opp.market_id << " (ROI: " << opp.potential_roi_v2 << "%)" << endl;
-        } else {
-            signal.action = "MONITOR";
-        }
-        
-        auto end_time = chrono::high_resolution_clock::now();
-        auto duration = chrono::duration_cast<chrono::microseconds>(end_time - start_time);
-        
-        signal.reaction_time = duration.count() / 1000; // in ms
-        signal.execution_time = 1000; // estimation
-        signal.total_time = signal.reaction_time + signal.execution_time;
-        signal.grade = "B";
-        
-        signals.push_back(signal);
+    bool start(const string& feed_url) {
+        if (running.exchange(true)) return false;
+        if (!feed_url.empty()) url = feed_url;
+        worker = thread([this] { run(); });
+        return true;
     }
     
-    // Appliquer la priorisation par ROI pour éviter les conflits de timing
-    signals = prioritize_trades_by_roi(signals);
+    void stop() {
+        if (!running.exchange(false)) return;
+        if (worker.joinable()) worker.join();
+    }
     
-    return signals;
-}
+    bool is_running() const { return running.load(memory_order_acquire); }
+};
+
+MarketFeed market_feed;
 
 // FFI functions for Rust
 extern "C" {
@@ -578,6 +6256,12 @@ extern "C" {
     bool init_polymarket_core() {
         cout << "Initializing C++ Polymarket Core module" << endl;
         
+        if (!http_pool.init()) {
+            cout << "[ERROR] Failed to initialize HTTP connection pool" << endl;
+            return false;
+        }
+        cout << "[OK] HTTP pool: " << HTTP_POOL_SIZE << " persistent clients (keep-alive, HTTP/2, shared DNS/TLS cache)" << endl;
+        
             // NOUVEAU SYSTÈME: 1€ direct sur le meilleur trade
     cout << "🚀 SYSTÈME AUTOMATIQUE ACTIVÉ" << endl;
     cout << "   • Priorisation par ROI automatique" << endl;
@@ -588,149 +6272,467 @@ extern "C" {
         return true;
     }
     
+    // Arrêt anticipé des transferts sources: 0 = jamais, 1 = tous les mots-clés trouvés, 2 = premier mot-clé
+    void configure_source_stream_abort(int mode) {
+        if (mode < 0 || mode > 2) mode = 0;
+        source_stream_abort_mode.store(mode, memory_order_relaxed);
+    }
+    
+    // Attend l'écriture des logs asynchrones en attente (ex: avant un affichage Rust)
+    void flush_core_logs() {
+        core_log.flush();
+    }
+    
+    // Nombre de messages de log perdus (ring plein)
+    uint64_t get_core_log_dropped() {
+        return core_log.dropped_count();
+    }
+    
     // Configure ROI parameters
     void configure_roi_params(double fee, double catchup_speed, double action_time) {
-        GLOBAL_FEE = fee;
-        GLOBAL_CATCHUP_SPEED = catchup_speed;
-        GLOBAL_ACTION_TIME = action_time;
+        live_roi.update([&](RoiContext& context) {
+            context.fee = fee;
+            context.catchup_speed = catchup_speed;
+            context.action_time = action_time;
+        });
+        roi_params_version.fetch_add(1, memory_order_release); // invalide tout le cache ROI
+        roi_table_builder.request_rebuild();
         cout << "ROI params configured: fee=" << fee << ", catchup_speed=" << catchup_speed << ", action_time=" << action_time << endl;
     }
     
+    // Contexte ROI live complet (coût fixe et π compris); configure_roi_params n'en change que trois
+    void configure_roi_context(const RoiContext_C* context) {
+        if (!context) return;
+        live_roi.update([&](RoiContext& live) {
+            live = {context->fee, context->catchup_speed, context->action_time, context->fixed_cost, context->pi_yes};
+        });
+        roi_params_version.fetch_add(1, memory_order_release);
+        roi_table_builder.request_rebuild();
+    }
+    
+    void get_roi_context(RoiContext_C* out) {
+        if (!out) return;
+        RoiContext live = live_roi.load();
+        *out = {live.fee, live.catchup_speed, live.action_time, live.fixed_cost, live.pi_yes};
+    }
+    
+    // Calibrage: un point par contexte de grid sur un lot de marchés (prix YES, outcome 1 = YES,
+    // 0 = NO, autre = non résolu; outcomes = nullptr: ROI attendu seul), réparti par vol de travail
+    // sur threads (0: tous les cœurs). N'utilise ni ne modifie le contexte live: sans risque
+    // pendant que le pipeline tourne. Sorties de n_params valeurs (optionnelles sauf la première),
+    // NaN sans trade / sans trade résolu. Renvoie le nombre de points écrits.
+    size_t sweep_roi_params(const RoiContext_C* grid, size_t n_params, const double* prices, const uint8_t* outcomes,
+                            size_t n_markets, size_t threads, double* out_expected_roi, double* out_hit_rate,
+                            double* out_realized_roi, uint32_t* out_trades) {
+        if (!grid || !prices || !out_expected_roi || n_params == 0) return 0;
+        vector<RoiContext> contexts(n_params);
+        for (size_t i = 0; i < n_params; i++) {
+            contexts[i] = {grid[i].fee, grid[i].catchup_speed, grid[i].action_time, grid[i].fixed_cost, grid[i].pi_yes};
+        }
+        vector<RoiSweepPoint> points = sweep_roi_contexts(contexts, prices, outcomes, n_markets, threads);
+        for (size_t i = 0; i < n_params; i++) {
+            out_expected_roi[i] = points[i].expected_roi;
+            if (out_hit_rate) out_hit_rate[i] = points[i].hit_rate;
+            if (out_realized_roi) out_realized_roi[i] = points[i].realized_roi;
+            if (out_trades) out_trades[i] = points[i].trades;
+        }
+        return n_params;
+    }
+    
+    // Trace ROI: max_per_second = 0 désactive; sink = nullptr écrit sur stderr
+    void set_roi_trace_sink(void (*sink)(const char* line), int max_per_second) {
+        roi_trace_sink.store(sink, memory_order_release);
+        roi_trace_max_per_second.store(max(0, max_per_second), memory_order_relaxed);
+    }
+    
+    // ROI d'un lot de marchés en un seul appel FFI
+    // catchup_speeds / action_times: par marché, ou nullptr pour le contexte live
+    // out_bet_yes (optionnel): 1 si le pari est "OUI", 0 si "NON"
+    void calculate_real_roi_batch(const double* prices, size_t n, const double* catchup_speeds,
+                                  const double* action_times, double* out_roi, uint8_t* out_bet_yes) {
+        static const RoiBatchKernel kernel = select_roi_batch_kernel();
+        if (!prices || !out_roi || n == 0) return;
+        
+        RoiContext params = live_roi.load();
+        kernel(params, prices, n, catchup_speeds, action_times, out_roi, out_bet_yes);
+    }
+    
     // FFI function to calculate realistic ROI
+    // fee, catchup_speed, action_time: conservés pour l'ABI Rust, le calcul suit le contexte live
     double calculate_real_roi_cpp(double current_price, double fee, double catchup_speed, double action_time) {
-        return calculate_real_roi(current_price, fee, catchup_speed, action_time);
+        (void)fee;
+        (void)catchup_speed;
+        (void)action_time;
+        return calculate_real_roi(live_roi.load(), current_price);
     }
     
     // Update market data
+    // Le réseau (marchés, sources) est fait hors verrou; seule la réévaluation et la
+    // publication de la nouvelle version sont sérialisées avec le flux temps réel.
+    // Les lecteurs gardent l'ancienne version jusqu'à la publication, sans jamais attendre.
     bool update_market_data() {
-        FastHTTPClient client;
+        // Pool non initialisé (curl_global_init en échec): aucun client ni poller à utiliser
+        if (!http_pool.init()) return false;
         
-        // Fetch markets
-        auto fetched_markets = fetch_polymarket_markets(client);
+        auto base = std::atomic_load(&core_state);
+        PooledClient client;
+        MultiSourcePoller* poller = http_pool.source_poller();
+        if (!client || !poller) return false;
+        StageTimes times;
         
-        {
-            lock_guard<mutex> lock(markets_mutex);
-            markets = fetched_markets;
-        }
-        
-        // Monitoring des sources
-        vector<string> sources = {
-            "https://fred.stlouisfed.org/series/FGEXPND",
-            "https://www.federalreserve.gov/monetarypolicy/openmarket.htm",
-            "https://www.bea.gov/data/gdp/gross-domestic-product",
-            "https://www.nber.org/",
-            "https://www.whitehouse.gov/",
-            "https://www.foxnews.com/",
-            "https://www.cnn.com/",
-            "https://www.sec.gov/",
-            "https://www.coinbase.com/",
-            "https://www.ethereum.org/"
-        };
+        // Fetch markets (échec: on garde l'univers précédent)
+        auto fetched_markets = make_shared<const vector<Market>>(fetch_polymarket_markets(*client, &times));
+        if (fetched_markets->empty()) fetched_markets = base->markets;
+        
+        // Monitoring des sources: seules celles que le planificateur juge utiles maintenant
+        auto poll_time = chrono::steady_clock::now();
+        vector<string> sources = source_scheduler.due(poll_time);
         
         vector<string> keywords = {"federal", "reserve", "rate", "gdp", "recession", "crypto", "bitcoin", "ethereum"};
         
-        vector<future<SourceData>> futures;
+        uint64_t poll_ns = pipeline_clock_ns();
+        vector<SourceData> polled = poller->poll(sources, keywords, base->source_data.get());
+        uint64_t observed_ns = times.lap(PipelineStage::FETCH, poll_ns); // dernière donnée du cycle reçue
         
-        for (const auto& source : sources) {
-            futures.push_back(async(launch::async, [&client, source, keywords]() {
-                return monitor_resolution_source(client, source, keywords);
-            }));
+        // Le prix temps réel, s'il existe, prime sur le prix du REST
+        vector<double> prices(fetched_markets->size());
+        for (size_t i = 0; i < prices.size(); i++) {
+            const Market& market = (*fetched_markets)[i];
+            double live;
+            bool has_live = market_feed.is_running() && market_feed.live_price(market_symbols.intern(market.id), live);
+            prices[i] = has_live ? live : market.probability;
         }
         
-        map<string, SourceData> new_source_data;
-        for (auto& future : futures) {
-            SourceData data = future.get();
-            new_source_data[data.url] = data;
+        lock_guard<mutex> writer(update_mutex);
+        auto previous = std::atomic_load(&core_state);
+        auto next = make_shared<CoreState>(*previous);
+        next->version = previous->version + 1;
+        
+        // Index reconstruit seulement si l'univers de marchés a changé
+        if (!market_index || !same_market_texts(*previous->markets, *fetched_markets)) {
+            uint64_t index_ns = pipeline_clock_ns();
+            market_index = make_shared<const MarketKeywordIndex>(*fetched_markets);
+            market_feed.set_markets(*fetched_markets);
+            source_scheduler.set_markets(*fetched_markets);
+            times.lap(PipelineStage::MATCH, index_ns);
+            history_store.record_markets(*fetched_markets);
         }
         
-        {
-            lock_guard<mutex> lock(source_data_mutex);
-            source_data = new_source_data;
+        // Sources non interrogées ce cycle: dernier état connu conservé
+        source_scheduler.observe(polled, *previous->source_data, poll_time);
+        history_store.record_sources(polled);
+        auto new_source_data = make_shared<map<string, SourceData>>();
+        for (const auto& entry : *previous->source_data) {
+            if (source_scheduler.contains(entry.first)) new_source_data->insert(entry);
+        }
+        for (auto& data : polled) {
+            (*new_source_data)[data.url] = move(data);
         }
         
-        // Détection d'opportunités
-        auto new_opportunities = detect_arbitrage_opportunities(markets, source_data);
+        next->markets = fetched_markets;
+        next->source_data = new_source_data;
         
-        {
-            lock_guard<mutex> lock(opportunities_mutex);
-            opportunities = new_opportunities;
-        }
+        // Détection incrémentale: seules les sources modifiées sont réévaluées
+        size_t changed = signal_pipeline.apply(*next->markets, market_index, *new_source_data, &prices, &times, observed_ns);
         
-        // Génération de signaux
-        auto new_signals = generate_trading_signals(opportunities);
+        publish_pipeline_state(move(next), changed > 0 || previous->markets != fetched_markets, &times);
+        pipeline_stats.record(times);
+        source_scheduler.refresh_demand(signal_pipeline);
+        history_store.record_ticks(*fetched_markets, prices, TickOrigin::REST);
         
-        {
-            lock_guard<mutex> lock(signals_mutex);
-            signals = new_signals;
-        }
+        auto published = std::atomic_load(&core_state);
+        PM_LOG(LogEvent::UPDATE_SUMMARY, published->markets->size(), published->opportunities->size(), published->signals->size());
         
-        cout << "[OK] Données mises à jour: " << markets.size() << " marchés, " 
-             << opportunities.size() << " opportunités, " << signals.size() << " signaux" << endl;
+        return true;
+    }
+    
+    // Taxonomie des marchés depuis un fichier JSON (voir BUILTIN_MARKET_TAXONOMY);
+    // false si illisible ou invalide, la taxonomie courante est alors conservée
+    bool load_market_taxonomy(const char* path) {
+        if (!path) return false;
+        ifstream in(path, ios::binary);
+        if (!in) return false;
+        stringstream ss;
+        ss << in.rdbuf();
+        auto taxonomy = MarketTaxonomy::compile(ss.str());
+        if (!taxonomy) return false;
+        
+        std::atomic_store(&installed_taxonomy, taxonomy);
+        lock_guard<mutex> writer(update_mutex);
+        market_index.reset(); // reclassement de l'univers au prochain cycle
+        return true;
+    }
+    
+    // Domaine d'un marché selon la taxonomie courante; "" si aucune règle ne correspond (l'appelant
+    // garde son libellé par défaut). Chaîne valide jusqu'à la fin du processus
+    const char* classify_market_domain(const char* question, const char* description) {
+        string domain;
+        vector<string> keywords;
+        auto taxonomy = current_taxonomy();
+        taxonomy->classify(question ? question : "", description ? description : "", domain, keywords);
+        if (domain == taxonomy->default_domain_name()) return "";
+        return domain_names.name(domain_names.intern(domain)).c_str();
+    }
+    
+    // Ajoute une source de résolution au planificateur; false si invalide, déjà connue ou limite atteinte
+    bool register_resolution_source(const char* url) {
+        return url && source_scheduler.add(url);
+    }
+    
+    // Budget global de relevés de sources (requêtes par seconde)
+    void configure_source_budget(double requests_per_second) {
+        source_request_budget.store(max(0.0, requests_per_second), memory_order_relaxed);
+    }
+    
+    // Changements par heure estimés pour une source planifiée (NaN si inconnue)
+    double get_source_change_rate(const char* url) {
+        return url ? source_scheduler.change_rate(string(url)) * 3600.0 : NAN;
+    }
+    
+    size_t get_scheduled_source_count() {
+        return source_scheduler.size();
+    }
+    
+    // Flux WebSocket du CLOB (prix temps réel); url = nullptr: endpoint par défaut
+    bool start_market_feed(const char* url) {
+        return market_feed.start(url ? url : "");
+    }
+    
+    void stop_market_feed() {
+        market_feed.stop();
+    }
+    
+    // Messages reçus / mises à jour de prix appliquées / reconnexions
+    uint64_t get_market_feed_messages() { return market_feed.messages.load(memory_order_relaxed); }
+    uint64_t get_market_feed_price_updates() { return market_feed.price_updates.load(memory_order_relaxed); }
+    uint64_t get_market_feed_reconnects() { return market_feed.reconnects.load(memory_order_relaxed); }
+    
+    // Historique SQLite (ticks, sources, signaux); reprend l'état des sources au démarrage
+    bool open_history_store(const char* path) {
+        if (!path || !history_store.open(path)) return false;
+        
+        map<string, SourceData> warm = history_store.load_latest_sources();
+        if (!warm.empty()) {
+            lock_guard<mutex> writer(update_mutex);
+            auto previous = std::atomic_load(&core_state);
+            if (previous->source_data->empty()) {
+                auto next = make_shared<CoreState>(*previous);
+                next->version = previous->version + 1;
+                next->source_data = make_shared<const map<string, SourceData>>(move(warm));
+                publish_core_state(move(next));
+            }
+        }
+        return true;
+    }
+    
+    void close_history_store() {
+        history_store.close();
+    }
+    
+    // Attend l'écriture des lignes en file
+    void flush_history_store() {
+        history_store.flush();
+    }
+    
+    // Ticks d'un marché entre from_ts et to_ts (secondes epoch), les cap plus récents en ordre chronologique
+    size_t query_market_ticks(const char* market_id, double from_ts, double to_ts, double* out_ts, double* out_price, size_t cap) {
+        if (!market_id || !out_ts || !out_price || cap == 0) return 0;
+        auto to_ms = [](double ts) { return (int64_t)min(max(ts * 1000.0, 0.0), 9.0e15); };
+        auto rows = history_store.query_ticks(market_id, to_ms(from_ts), to_ms(to_ts), cap);
+        for (size_t i = 0; i < rows.size(); i++) {
+            out_ts[i] = rows[i].first / 1000.0;
+            out_price[i] = rows[i].second;
+        }
+        return rows.size();
+    }
+    
+    // Journal binaire de rejeu (projeté en mémoire) depuis une base d'historique, fenêtre en secondes epoch
+    bool export_replay_log(const char* db_path, double from_ts, double to_ts, const char* out_path) {
+        if (!db_path || !out_path) return false;
+        auto to_ms = [](double ts) { return (int64_t)min(max(ts * 1000.0, 0.0), 9.0e15); };
+        ReplayLog log;
+        string error;
+        if (!log.load_sqlite(db_path, to_ms(from_ts), to_ms(to_ts), error) || !log.save_binary(out_path, error)) {
+            PM_LOG(LogEvent::HISTORY_ERROR, "replay", error);
+            return false;
+        }
+        return true;
+    }
+    
+    // Rejoue un journal (binaire ou base d'historique, fenêtre from_ts..to_ts pour cette dernière)
+    // une fois par jeu de paramètres ROI, en parallèle sur threads (0: tous les cœurs), sans
+    // toucher au pipeline live. fees / catchup_speeds / action_times: n valeurs, ou nullptr pour
+    // le contexte live. trace_prefix (optionnel): deltas du jeu i dans <trace_prefix>.<i>.csv.
+    // Renvoie le nombre de résultats écrits dans out (0 si le journal est illisible).
+    size_t run_replay_sweep(const char* log_path, double from_ts, double to_ts, const double* fees,
+                            const double* catchup_speeds, const double* action_times, size_t n, size_t threads,
+                            ReplayResult_C* out, const char* trace_prefix) {
+        if (!log_path || !out || n == 0) return 0;
+        auto to_ms = [](double ts) { return (int64_t)min(max(ts * 1000.0, 0.0), 9.0e15); };
+        ReplayLog log;
+        string error;
+        if (!log.load(log_path, to_ms(from_ts), to_ms(to_ts), error)) {
+            PM_LOG(LogEvent::HISTORY_ERROR, "replay", error);
+            return 0;
+        }
         
+        vector<RoiContext> grid(n, live_roi.load());
+        for (size_t i = 0; i < n; i++) {
+            if (fees) grid[i].fee = fees[i];
+            if (catchup_speeds) grid[i].catchup_speed = catchup_speeds[i];
+            if (action_times) grid[i].action_time = action_times[i];
+        }
+        vector<ReplayResult> results = replay_sweep(log, grid, threads, trace_prefix ? trace_prefix : "");
+        for (size_t i = 0; i < n; i++) {
+            const ReplayResult& r = results[i];
+            out[i] = {r.events, r.cycles, r.signals, r.executions, r.trades, r.wins, r.pnl, r.max_drawdown, r.signal_hash};
+        }
+        return n;
+    }
+    
+    uint64_t get_history_rows_written() { return history_store.written.load(memory_order_relaxed); }
+    uint64_t get_history_rows_dropped() { return history_store.dropped.load(memory_order_relaxed); }
+    
+    // Carnets L2: mise en parts utilisée pour le ROI au VWAP (0 = modèle seul)
+    void configure_depth_stake(double shares) {
+        depth_stake.store(max(0.0, shares), memory_order_relaxed);
+        roi_params_version.fetch_add(1, memory_order_release); // re-pricing complet au prochain cycle
+        roi_table_builder.request_rebuild();
+    }
+    
+    // Instantané du carnet "Yes" d'un marché (ex: carnet REST côté Rust); remplace l'existant
+    bool load_order_book(const char* market_id, const double* bid_prices, const double* bid_sizes, size_t n_bids,
+                         const double* ask_prices, const double* ask_sizes, size_t n_asks) {
+        if (!market_id) return false;
+        order_books.update(market_symbols.intern(market_id), [&](L2Book& book) {
+            book.replace(true, bid_prices, bid_sizes, n_bids);
+            book.replace(false, ask_prices, ask_sizes, n_asks);
+        });
         return true;
     }
     
+    bool get_order_book_top(const char* market_id, double* best_bid, double* best_ask) {
+        if (!market_id) return false;
+        uint32_t market = market_symbols.find(market_id);
+        if (market == StringInterner::NONE) return false;
+        return order_books.read(market, [&](const L2Book& book) {
+            if (best_bid) *best_bid = book.best_bid();
+            if (best_ask) *best_ask = book.best_ask();
+        });
+    }
+    
+    // VWAP pour shares parts (buy: asks, sinon bids); NaN si carnet absent ou trop peu profond
+    double get_order_book_vwap(const char* market_id, bool buy, double shares) {
+        double vwap = NAN;
+        uint32_t market = market_id ? market_symbols.find(market_id) : StringInterner::NONE;
+        if (market == StringInterner::NONE) return vwap;
+        order_books.read(market, [&](const L2Book& book) {
+            BookFill fill = buy ? book.fill_buy(shares) : book.fill_sell(shares);
+            if (fill.complete(shares)) vwap = fill.vwap();
+        });
+        return vwap;
+    }
+    
+    // ROI d'une mise de stake parts au VWAP du carnet; NaN si carnet absent ou trop peu profond
+    double calculate_depth_roi_cpp(const char* market_id, double stake, bool bet_on_yes) {
+        double roi = NAN;
+        uint32_t market = market_id ? market_symbols.find(market_id) : StringInterner::NONE;
+        if (market == StringInterner::NONE) return roi;
+        order_books.read(market, [&](const L2Book& book) {
+            if (!depth_roi(book, bet_on_yes, stake, live_roi.load(), roi)) roi = NAN;
+        });
+        return roi;
+    }
+    
     // Obtenir le nombre de marchés
     int get_markets_count() {
-        lock_guard<mutex> lock(markets_mutex);
-        return markets.size();
+        return markets_count.load(memory_order_relaxed);
     }
     
     // Obtenir le nombre d'opportunités
     int get_opportunities_count() {
-        lock_guard<mutex> lock(opportunities_mutex);
-        return opportunities.size();
+        return opportunities_count.load(memory_order_relaxed);
     }
     
     // Obtenir le nombre de signaux
     int get_signals_count() {
-        lock_guard<mutex> lock(signals_mutex);
-        return signals.size();
+        return signals_count.load(memory_order_relaxed);
+    }
+    
+    // Signaux nouveaux ou modifiés depuis le dernier appel (au plus cap), un par marché.
+    // action "CLEAR": le marché n'a plus de signal. Chaînes valides jusqu'au prochain appel.
+    size_t fetch_signal_deltas(TradingSignal_C* out, size_t cap) {
+        if (!out || cap == 0) return 0;
+        return signal_deltas.drain(out, cap);
+    }
+    
+    // Nombre de trades retenus par la priorisation (0 = tous; ex: le meilleur trade seul = 1)
+    void configure_trade_top_k(size_t k) {
+        trade_top_k.store(k, memory_order_relaxed);
+    }
+    
+    // Emprunte le dernier instantané publié (false si aucun cycle n'a encore abouti).
+    // Les pointeurs de *out restent valides jusqu'à release_core_snapshot(out->generation).
+    bool acquire_core_snapshot(CoreSnapshot_C* out) {
+        if (!out) return false;
+        auto snapshot = std::atomic_load(&published_snapshot);
+        if (!snapshot) return false;
+        
+        {
+            lock_guard<mutex> lock(snapshot_leases_mutex);
+            auto& lease = snapshot_leases[snapshot->generation];
+            if (lease.second++ == 0) lease.first = snapshot;
+        }
+        
+        out->generation = snapshot->generation;
+        out->markets = snapshot->markets.data();
+        out->market_count = snapshot->markets.size();
+        out->opportunities = snapshot->opportunities.data();
+        out->opportunity_count = snapshot->opportunities.size();
+        out->signals = snapshot->signals.data();
+        out->signal_count = snapshot->signals.size();
+        return true;
+    }
+    
+    // Rend un instantané emprunté; libéré au dernier emprunt s'il n'est plus le plus récent
+    void release_core_snapshot(uint64_t generation) {
+        lock_guard<mutex> lock(snapshot_leases_mutex);
+        auto it = snapshot_leases.find(generation);
+        if (it == snapshot_leases.end()) return;
+        if (--it->second.second == 0) snapshot_leases.erase(it);
+    }
+    
+    // Génération du dernier instantané publié (0: aucun), pour un sondage sans emprunt
+    uint64_t get_core_snapshot_generation() {
+        auto snapshot = std::atomic_load(&published_snapshot);
+        return snapshot ? snapshot->generation : 0;
+    }
+    
+    // Nombre de deltas en attente de lecture
+    size_t get_pending_signal_deltas() {
+        return signal_deltas.size();
     }
     
     // Exécuter un trade (appelé par Rust)
     bool execute_trade_cpp(const char* market_id, const char* action, double amount) {
-        cout << "Exécution de trade C++:" << endl;
-        cout << "   Market ID: " << market_id << endl;
-        cout << "   Action: " << action << endl;
-        cout << "   Amount: " << amount << " ETH" << endl;
+        PM_LOG(LogEvent::TRADE_REQUEST, market_id, action, amount);
         
         // Ici vous pouvez ajouter la logique d'exécution spécifique
         // Par exemple, appel direct à l'API Polymarket
         
-        cout << "[OK] Trade exécuté avec succès" << endl;
         return true;
     }
 
     // ===== FONCTIONS HFT ULTRA-OPTIMISÉES =====
     
-    // Calcul ROI ultra-rapide avec cache (latence < 1μs)
+    // Calcul ROI ultra-rapide avec cache (latence < 1μs), au contexte live. fee, catchup_speed et
+    // action_time restent dans la signature pour l'ABI Rust mais ne sont pas utilisés:
+    // les paramètres se changent par configure_roi_params / configure_roi_context
     double calculate_roi_hft_cached(double current_price, double fee, double catchup_speed, double action_time) {
-        // Clé de cache pour éviter les recalculs
-        std::string cache_key = std::to_string(current_price) + "_" + std::to_string(fee) + "_" + 
-                          std::to_string(catchup_speed) + "_" + std::to_string(action_time);
-        
-        {
-            std::lock_guard<std::mutex> lock(roi_cache_mutex);
-            auto it = roi_cache.find(cache_key);
-            if (it != roi_cache.end()) {
-                return it->second; // Cache hit - retour immédiat
-            }
-        }
-        
-            // Cache miss - calcul rapide avec paramètres FORCÉS pour test
-    double roi = calculate_real_roi(current_price, GLOBAL_FEE, GLOBAL_CATCHUP_SPEED, GLOBAL_ACTION_TIME);
-        
-        // Mise en cache avec gestion de la taille
-        {
-            std::lock_guard<std::mutex> lock(roi_cache_mutex);
-            if (roi_cache.size() >= MAX_CACHE_SIZE) {
-                roi_cache.clear(); // Reset si trop plein
-            }
-            roi_cache[cache_key] = roi;
-        }
-        
-        return roi;
+        (void)fee;
+        (void)catchup_speed;
+        (void)action_time;
+        return cached_live_roi(current_price);
     }
     
     // Décision de trading ultra-rapide (latence < 100ns) - OPTIMISÉE HFT
@@ -748,12 +6750,11 @@ extern "C" {
     // Calcul de position size ultra-rapide (latence < 50ns) - OPTIMISÉE HFT
     // NOUVEAU SYSTÈME: 1€ direct sur le trade avec le ROI le plus élevé
     double calculate_position_size_hft(double capital, double roi, const char* confidence) {
-        // SYSTÈME SIMPLIFIÉ: 1€ direct sur le meilleur trade
+        (void)capital; // SYSTÈME SIMPLIFIÉ: 1€ direct sur le meilleur trade, quel que soit le capital
         double position_amount = 1.0; // 1€ fixe
         
         // Log pour debug
-        cout << "[TRADE] Position: " << fixed << setprecision(2) << position_amount 
-             << "€ (ROI: " << (roi * 100) << "%, confiance: " << confidence << ")" << endl;
+        PM_LOG(LogEvent::POSITION_SIZE, confidence, position_amount, roi);
         
         return position_amount;
     }
@@ -766,52 +6767,83 @@ extern "C" {
         return true;
     }
     
-    // Calcul de latence réseau estimée (latence < 10ns)
+    // Latence réseau estimée (secondes): médiane mesurée sur tous les hôtes, 45ms sans mesure
     double estimate_network_latency_hft() {
-        // Valeurs précalculées basées sur l'historique
-        static double avg_latency = 0.045;
-        static double jitter = 0.010;
-        
-        return avg_latency + (rand() % 100 - 50) * jitter / 100.0;
+        const HostLatency& all = latency_model.overall();
+        if (all.total_histogram.count() >= LATENCY_MIN_SAMPLES) return all.total_histogram.quantile(0.5);
+        double ewma = all.total.get();
+        return std::isnan(ewma) ? 0.045 : ewma;
     }
     
-    // Prédiction de latence
+    // Prédiction de latence (secondes) d'un hôte ou d'une URL
     double predict_latency_hft(const char* endpoint) {
-        // Lookup table pour latences précalculées
-        static std::map<std::string, double> latency_table = {
-            {"gamma-api.polymarket.com", 0.035},  // 35ms
-            {"clob.polymarket.com", 0.040},       // 40ms
-            {"api.stlouisfed.org", 0.050},        // 50ms
-            {"www.federalreserve.gov", 0.045},    // 45ms
-            {"www.sec.gov", 0.055},               // 55ms
-            {"www.coindesk.com", 0.060}           // 60ms
+        return endpoint ? predicted_latency(latency_host_key(endpoint)) : 0.050;
+    }
+    
+    // Quantile q (0..1) du temps total d'un hôte (nullptr: tous), en secondes; NaN sans mesure
+    double get_host_latency_quantile(const char* host, double q) {
+        const HostLatency* latency = host ? latency_model.host(latency_host_key(host), false) : &latency_model.overall();
+        return latency ? latency->total_histogram.quantile(q) : NAN;
+    }
+    
+    // Statistiques d'un hôte (nullptr: tous); false si l'hôte n'a jamais été contacté
+    bool get_host_latency_stats(const char* host, HostLatencyStats_C* out) {
+        if (!out) return false;
+        const HostLatency* latency = host ? latency_model.host(latency_host_key(host), false) : &latency_model.overall();
+        if (!latency) return false;
+        out->samples = latency->total_histogram.count();
+        out->failures = latency->failures.load(memory_order_relaxed);
+        out->dns_ewma = latency->dns.get();
+        out->connect_ewma = latency->connect.get();
+        out->tls_ewma = latency->tls.get();
+        out->ttfb_ewma = latency->ttfb.get();
+        out->total_ewma = latency->total.get();
+        out->ttfb_p50 = latency->ttfb_histogram.quantile(0.5);
+        out->ttfb_p99 = latency->ttfb_histogram.quantile(0.99);
+        out->total_p50 = latency->total_histogram.quantile(0.5);
+        out->total_p99 = latency->total_histogram.quantile(0.99);
+        return true;
+    }
+    
+    // Distributions p50/p99/max par étape du chemin critique depuis le démarrage
+    void get_pipeline_stats(PipelineStats_C* out) {
+        if (!out) return;
+        auto fill = [](const LatencyHistogram& histogram, StageLatency_C& stage) {
+            stage.count = histogram.count();
+            stage.p50_us = histogram.quantile_value(0.5) / 1e3;
+            stage.p99_us = histogram.quantile_value(0.99) / 1e3;
+            stage.max_us = stage.count ? histogram.max_value() / 1e3 : NAN;
         };
-        
-        std::string key(endpoint);
-        auto it = latency_table.find(key);
-        return (it != latency_table.end()) ? it->second : 0.050; // 50ms par défaut
+        fill(pipeline_stats.stage(PipelineStage::FETCH), out->fetch);
+        fill(pipeline_stats.stage(PipelineStage::PARSE), out->parse);
+        fill(pipeline_stats.stage(PipelineStage::MATCH), out->match);
+        fill(pipeline_stats.stage(PipelineStage::DETECT), out->detect);
+        fill(pipeline_stats.stage(PipelineStage::PRICE), out->price);
+        fill(pipeline_stats.stage(PipelineStage::DECIDE), out->decide);
+        fill(pipeline_stats.stage(PipelineStage::EMIT), out->emit);
+        fill(pipeline_stats.reaction, out->reaction);
+        fill(pipeline_stats.end_to_end, out->end_to_end);
     }
     
     // Optimisation mémoire pour HFT
+    // Construit la lookup table ROI de façon synchrone si elle manque ou est périmée
     void optimize_memory_hft() {
-        // Pré-allocation des vecteurs pour éviter les reallocations
-        precomputed_roi_table.reserve(10000);
-        
-        // Initialisation de la lookup table ROI
-        if (!roi_table_initialized) {
-            for (int i = 0; i < 10000; i++) {
-                double price = i / 10000.0;
-                precomputed_roi_table.push_back(calculate_real_roi(price, GLOBAL_FEE, GLOBAL_CATCHUP_SPEED, GLOBAL_ACTION_TIME));
-            }
-            roi_table_initialized = true;
+        auto table = std::atomic_load(&precomputed_roi_table);
+        if (!table || table->params_version != roi_params_version.load(std::memory_order_acquire)) {
+            std::atomic_store(&precomputed_roi_table, build_roi_table());
         }
     }
     
-    // Fonction de nettoyage périodique pour éviter la fragmentation mémoire
+    // ROI en O(1) depuis la table précalculée (interpolation linéaire entre ticks)
+    double calculate_roi_table_cpp(double price) {
+        return lookup_roi_table(price);
+    }
+    
+    // Nettoyage périodique: le cache ROI est un tableau fixe (aucune fragmentation) versionné
+    // par les paramètres ROI, rien à invalider ici; l'arène du pipeline rend la mémoire gardée
+    // après un pic
     void cleanup_hft_cache() {
-        std::lock_guard<std::mutex> lock(roi_cache_mutex);
-        if (roi_cache.size() > MAX_CACHE_SIZE * 0.8) {
-            roi_cache.clear();
-        }
+        lock_guard<mutex> lock(update_mutex);
+        signal_pipeline.trim_arena();
     }
 }
@@ -0,0 +1,145 @@
+// Tests des parseurs de flux: pages CLOB /markets, trames WebSocket, taxonomie des marchés
+// Chaque cas affiche [OK] ou [FAIL]; le code de sortie est le nombre d'échecs.
+//
+// Build:   g++ -std=c++17 -O2 tests/feed_parsing_test.cpp -o feed_parsing_test -lcurl -lsqlite3 -pthread
+// Usage:   ./feed_parsing_test
+#define PM_LOG_LEVEL PM_LOG_LEVEL_OFF
+#include "../src/polymarket_core.cpp"
+#include <arpa/inet.h>
+#include <netinet/in.h>
+#include <sys/socket.h>
+
+static int failures = 0;
+
+static void check(bool condition, const char* name) {
+    printf("%s %s\n", condition ? "[OK]  " : "[FAIL]", name);
+    if (!condition) failures++;
+}
+
+// Champs texte à null (description, end_date_iso, outcome): lus comme vides, la page reste valide
+static void test_clob_page_null_fields() {
+    const string body =
+        "{\"data\": ["
+        "{\"condition_id\": \"0xaaa\", \"question\": \"Will the Fed cut rates?\", \"description\": null,"
+        " \"end_date_iso\": null, \"active\": true, \"closed\": false,"
+        " \"tokens\": [{\"token_id\": \"111\", \"outcome\": \"Yes\", \"price\": 0.42},"
+        "              {\"token_id\": \"222\", \"outcome\": null, \"price\": 0.58}]},"
+        "{\"condition_id\": \"0xbbb\", \"question\": \"Bitcoin above 100k?\", \"description\": \"Coinbase spot\","
+        " \"active\": true, \"closed\": false,"
+        " \"tokens\": [{\"token_id\": \"333\", \"outcome\": \"Yes\", \"price\": \"0.7\"}]}"
+        "], \"next_cursor\": null}";
+
+    vector<Market> markets;
+    bool ok = parse_clob_market_page(body, markets);
+    check(ok, "clob page with null fields parses");
+    check(markets.size() == 2, "clob page with null fields keeps both markets");
+    if (markets.size() != 2) return;
+    check(markets[0].id == "0xaaa" && markets[0].description.empty(), "null description reads as empty");
+    check(markets[0].probability == 0.42 && markets[0].yes_token_id == "111", "yes token found next to null outcome");
+    check(markets[1].id == "0xbbb" && markets[1].description == "Coinbase spot" && markets[1].probability == 0.7,
+          "market after null fields intact");
+    check(find_next_cursor(body).empty(), "null next_cursor ends pagination");
+}
+
+// Serveur WebSocket minimal sur 127.0.0.1: répond au handshake puis envoie une trame texte
+// de 200 Ko (en-tête 64 bits) en plusieurs écritures espacées, comme un gros snapshot "book"
+static void test_ws_frame_split_across_reads() {
+    int listener = socket(AF_INET, SOCK_STREAM, 0);
+    sockaddr_in addr{};
+    addr.sin_family = AF_INET;
+    addr.sin_addr.s_addr = htonl(INADDR_LOOPBACK);
+    socklen_t addr_len = sizeof(addr);
+    if (listener < 0 || bind(listener, (sockaddr*)&addr, sizeof(addr)) != 0 || listen(listener, 1) != 0 ||
+        getsockname(listener, (sockaddr*)&addr, &addr_len) != 0) {
+        check(false, "ws test server listens");
+        return;
+    }
+    
+    const string text(200000, 'b');
+    string frame = "\x81\x7f";
+    for (int shift = 56; shift >= 0; shift -= 8) frame += (char)((uint64_t)text.size() >> shift);
+    frame += text;
+    
+    thread server([&]() {
+        int conn = accept(listener, nullptr, nullptr);
+        if (conn < 0) return;
+        string request;
+        char buf[4096];
+        while (request.find("\r\n\r\n") == string::npos) {
+            ssize_t n = recv(conn, buf, sizeof(buf), 0);
+            if (n <= 0) { ::close(conn); return; }
+            request.append(buf, n);
+        }
+        string response = "HTTP/1.1 101 Switching Protocols\r\nUpgrade: websocket\r\nConnection: Upgrade\r\n\r\n";
+        send(conn, response.data(), response.size(), 0);
+        // Premier morceau: en-tête complet + début du payload, puis le reste en 4 écritures
+        size_t cuts[] = {0, 1000, 50000, 100000, 150000, frame.size()};
+        for (size_t i = 0; i + 1 < sizeof(cuts) / sizeof(cuts[0]); i++) {
+            send(conn, frame.data() + cuts[i], cuts[i + 1] - cuts[i], 0);
+            this_thread::sleep_for(chrono::milliseconds(30));
+        }
+        this_thread::sleep_for(chrono::milliseconds(500));
+        ::close(conn);
+    });
+    
+    WebSocketConnection ws;
+    bool connected = ws.connect("ws://127.0.0.1:" + to_string(ntohs(addr.sin_port)) + "/ws/market", 2000);
+    check(connected, "ws handshake with local server");
+    
+    size_t received = 0;
+    bool intact = false;
+    auto deadline = chrono::steady_clock::now() + chrono::seconds(2);
+    while (connected && received == 0 && chrono::steady_clock::now() < deadline) {
+        if (!ws.poll(50, [&](string_view message) {
+                received++;
+                intact = message == text;
+            })) break;
+    }
+    check(received == 1 && intact, "ws frame split across reads is delivered whole");
+    
+    ws.close();
+    server.join();
+    ::close(listener);
+}
+
+// Domaines attendus de la taxonomie intégrée (ordre de priorité economy > politics > crypto)
+// et de config/market_taxonomy.json quand le test est lancé depuis la racine du dépôt
+static void test_market_taxonomy() {
+    struct Case { const char* question; const char* domain; };
+    const Case cases[] = {
+        {"Will the Senate confirm the nominee?", "politics"},
+        {"Will Congress pass the budget?", "politics"},
+        {"Will Trump win the election?", "politics"},
+        {"Will Bitcoin reach $150k?", "crypto"},
+        {"Will NFT volumes recover?", "crypto"},
+        {"Will inflation exceed 3% in 2025?", "economy"},
+        {"Will the Fed cut rates in March?", "economy"},
+        {"Bitcoin above 100k after the Fed cut?", "economy"},
+        {"Who wins the sports final?", "sports"},
+        {"Will it snow in Paris on Christmas?", ""},
+    };
+    
+    auto check_cases = [&](const char* taxonomy_name) {
+        for (const auto& c : cases) {
+            string name = string(taxonomy_name) + ": \"" + c.question + "\" -> " + (*c.domain ? c.domain : "(default)");
+            check(string(classify_market_domain(c.question, "")) == c.domain, name.c_str());
+        }
+    };
+    check_cases("builtin");
+    
+    ifstream config("config/market_taxonomy.json");
+    if (!config) {
+        printf("[SKIP] config/market_taxonomy.json not found (run from the repository root)\n");
+        return;
+    }
+    check(load_market_taxonomy("config/market_taxonomy.json"), "config taxonomy loads");
+    check_cases("config");
+}
+
+int main() {
+    test_clob_page_null_fields();
+    test_ws_frame_split_across_reads();
+    test_market_taxonomy();
+    printf("%d failure(s)\n", failures);
+    return failures;
+}